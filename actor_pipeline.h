@@ -0,0 +1,88 @@
+// =====================================================
+// aino_pro/systems/actor_pipeline.hpp
+// =====================================================
+
+#pragma once
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "../aino_pro.hpp"
+#include "physiological_actor.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 常见功能组合（编译期实例化）
+static constexpr uint32_t PIPELINE_FULL = FEATURE_ALL;                              // 主角
+static constexpr uint32_t PIPELINE_NO_HYSTERESIS = FEATURE_ALL & ~FEATURE_HYSTERESIS;
+static constexpr uint32_t PIPELINE_CROWD = FEATURE_NEURAL | FEATURE_EMOTION;        // 人群
+static constexpr uint32_t PIPELINE_MOTOR = FEATURE_NEURAL;                          // 纯运动
+
+using PipelineBatchFn = void(*)(PhysiologicalActor* const* actors, const PhysioBridge* inputs,
+                                size_t count, float dt, const Config& cfg);
+
+// 单批次：组合在编译期固定，循环内无功能开关分支
+template<uint32_t Features, Accuracy Acc, bool Dynamic = false>
+void run_pipeline_batch(PhysiologicalActor* const* actors, const PhysioBridge* inputs,
+                        size_t count, float dt, const Config& cfg) {
+    for(size_t i = 0; i < count; ++i) {
+        actors[i]->template run_pipeline<Features, Acc, Dynamic>(dt, inputs[i], cfg);
+    }
+}
+
+class ActorPipelines {
+    struct Entry {
+        uint32_t features;
+        PipelineBatchFn fn;
+    };
+    
+    template<Accuracy Acc>
+    static constexpr std::array<Entry, 4> entries_for() {
+        return {{
+            {PIPELINE_FULL,          &run_pipeline_batch<PIPELINE_FULL, Acc>},
+            {PIPELINE_NO_HYSTERESIS, &run_pipeline_batch<PIPELINE_NO_HYSTERESIS, Acc>},
+            {PIPELINE_CROWD,         &run_pipeline_batch<PIPELINE_CROWD, Acc>},
+            {PIPELINE_MOTOR,         &run_pipeline_batch<PIPELINE_MOTOR, Acc>}
+        }};
+    }
+    
+    template<size_t N>
+    static PipelineBatchFn find_in(const std::array<Entry, N>& table, uint32_t features) {
+        for(const auto& e : table) {
+            if(e.features == features) return e.fn;
+        }
+        return nullptr;
+    }
+    
+public:
+    // 查找特化流水线；未实例化的组合返回运行时回退
+    [[nodiscard]] static PipelineBatchFn select(uint32_t features, Accuracy acc) {
+        PipelineBatchFn fn = nullptr;
+        switch(acc) {
+            case Accuracy::Realtime:  fn = find_in(entries_for<Accuracy::Realtime>(), features); break;
+            case Accuracy::Standard:  fn = find_in(entries_for<Accuracy::Standard>(), features); break;
+            case Accuracy::High:      fn = find_in(entries_for<Accuracy::High>(), features); break;
+            case Accuracy::Surrogate: fn = find_in(entries_for<Accuracy::Surrogate>(), features); break;
+            default: break;
+        }
+        return fn ? fn : &run_pipeline_batch<FEATURE_ALL, Accuracy::Standard, true>;
+    }
+    
+    // 批量更新：配置每批读取一次，分派一次（同一批次须属于同一上下文）
+    static void update_batch(const EngineContext& ctx, PhysiologicalActor* const* actors,
+                             const PhysioBridge* inputs, size_t count, float dt) {
+        const auto cfg = ctx.get_config();
+        select(feature_mask(cfg->features), cfg->accuracy)(actors, inputs, count, dt, *cfg);
+    }
+    
+    static void update_batch(const std::vector<PhysiologicalActor*>& actors,
+                             const std::vector<PhysioBridge>& inputs, float dt) {
+        if(actors.empty()) return;
+        update_batch(actors.front()->get_context(), actors.data(), inputs.data(),
+                     std::min(actors.size(), inputs.size()), dt);
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -5,7 +5,11 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
 #include <unordered_map>
+#include <string>
 #include "aino_math.hpp"
 
 namespace aino_animation {
@@ -13,9 +17,16 @@ namespace aino_animation {
 struct PoseBuffer {
     std::vector<float> rotation_z;
     size_t bone_count = 0;
+    uint64_t version = 0;   // 内容版本（节点写入后刷新；复用缓存时恢复旧版本）
     
     PoseBuffer(size_t bones = 23) : bone_count(bones), rotation_z(bones, 0.0f) {}
     
+    // 全局唯一版本号：不同节点写出的姿态不会碰巧同号
+    void touch() {
+        static std::atomic<uint64_t> counter{0};
+        version = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    
     void write_bone_channel(size_t bone_index, const char* channel, __m128 value) {
         if(bone_index >= bone_count) return;
         float temp[4];
@@ -24,25 +35,148 @@ struct PoseBuffer {
     }
 };
 
+// 只读连续视图（C++17 无 std::span）
+template<typename T>
+struct Span {
+    const T* ptr = nullptr;
+    size_t count = 0;
+    
+    Span() = default;
+    Span(const T* p, size_t n) : ptr(p), count(n) {}
+    Span(const std::vector<T>& v) : ptr(v.data()), count(v.size()) {}
+    
+    [[nodiscard]] const T* data() const { return ptr; }
+    [[nodiscard]] size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + count; }
+    const T& operator[](size_t i) const { return ptr[i]; }
+};
+
+// 类型化输入通道：构图时绑定到上游节点持有的缓冲，求值时零拷贝读取
+//   绑定 vector 时按对象跟踪（上游 resize 后仍有效）；绑定裸指针时长度固定
+template<typename T>
+class InputChannel {
+    const std::vector<T>* source = nullptr;
+    const T* raw = nullptr;
+    size_t raw_count = 0;
+    
+public:
+    void bind(const std::vector<T>& v) { source = &v; raw = nullptr; raw_count = 0; }
+    void bind(const T* p, size_t n) { source = nullptr; raw = p; raw_count = n; }
+    void unbind() { source = nullptr; raw = nullptr; raw_count = 0; }
+    
+    [[nodiscard]] bool bound() const { return source || raw; }
+    [[nodiscard]] Span<T> view() const {
+        return source ? Span<T>(*source) : Span<T>(raw, raw_count);
+    }
+};
+
 struct AnimationContext {
     double delta_time = 0.0;
     PoseBuffer* output = nullptr;
     std::unordered_map<std::string, float> parameters;
+    uint64_t parameter_version = 0;   // 参数变化计数（静态节点据此判断是否重算）
+    
+    // 值变化时才推进版本；直接改 parameters 需自行 ++parameter_version
+    void set_parameter(const std::string& name, float value) {
+        auto it = parameters.find(name);
+        if(it != parameters.end() && it->second == value) return;
+        parameters[name] = value;
+        ++parameter_version;
+    }
     
     struct {
         float stress = 0.0f;
     } emotion;
 };
 
+// 增量求值（脏标记）：
+//   静态节点（is_static，无随时间演化的内部状态）在 输入姿态版本 / 参数版本 /
+//   内部状态版本 / 上游节点 均未变化时，直接复用上次输出姿态，不调用 on_evaluate；
+//   复用时恢复上次的输出版本号，下游节点随之判定为未变化（惰性传播）
+//   输入姿态视为未变：版本等于上次的输入；幂等节点（is_idempotent）另接受本节点上次的输出
+//   （持久缓冲跨帧时上一帧结束停在本节点输出上，幂等节点对其再求值结果不变）
 class AnimationNodeBase {
+    // 上次求值的输入键与输出
+    struct Cache {
+        bool valid = false;
+        uint64_t input_pose = 0;
+        uint64_t parameters = 0;
+        uint64_t state = 0;
+        PoseBuffer pose{0};
+    } cache;
+    uint64_t state_version = 0;
+    
 public:
     virtual ~AnimationNodeBase() = default;
-    virtual void evaluate(AnimationContext& ctx) = 0;
-    void add_child(std::shared_ptr<AnimationNodeBase> child) { children.push_back(child); }
+    
+    virtual void evaluate(AnimationContext& ctx) {
+        if(reuse_cached(ctx)) return;
+        
+        // 先刷新版本再写入：本节点内递归求值的子节点看到的是新输入
+        const uint64_t input_pose = ctx.output ? ctx.output->version : 0;
+        if(ctx.output) ctx.output->touch();
+        on_evaluate(ctx);
+        
+        if(ctx.output && is_static()) {
+            cache.valid = true;
+            cache.input_pose = input_pose;
+            cache.parameters = ctx.parameter_version;
+            cache.state = state_version;
+            cache.pose.rotation_z.assign(ctx.output->rotation_z.begin(), ctx.output->rotation_z.end());
+            cache.pose.bone_count = ctx.output->bone_count;
+            cache.pose.version = ctx.output->version;
+        }
+    }
+    
+    void add_child(std::shared_ptr<AnimationNodeBase> child) {
+        children.push_back(child);
+        mark_dirty();
+    }
+    
+    // 内部状态被外部修改（参数设置、重新绑定等）时调用
+    void mark_dirty() { ++state_version; }
+    
+    // 默认视为动态节点（每帧求值）；输出只取决于 输入姿态 / 参数 / 内部状态 / 上游 的节点
+    // （无随时间演化的状态，如姿态变换、混合、叠加）可覆盖为 true
+    [[nodiscard]] virtual bool is_static() const { return false; }
+    
+    // 对自身输出再求值结果不变（输出不读取输入姿态，如整体覆盖写入的节点）；
+    // 混合 / 叠加节点读取输入姿态，须保持 false，否则持久缓冲上会被跳过重算
+    [[nodiscard]] virtual bool is_idempotent() const { return false; }
+    
+    // 自上次求值以来（不计输入姿态与参数）是否未发生变化：自身静态 + 上游均未变
+    [[nodiscard]] bool unchanged() const {
+        return is_static() && cache.valid && cache.state == state_version && inputs_unchanged();
+    }
     
 protected:
     virtual void on_evaluate(AnimationContext& ctx) = 0;
+    
+    // 上游节点；子类有额外输入（如被包装的节点）时覆盖
+    [[nodiscard]] virtual bool inputs_unchanged() const {
+        for(const auto& child : children) {
+            if(!child->unchanged()) return false;
+        }
+        return true;
+    }
+    
     std::vector<std::shared_ptr<AnimationNodeBase>> children;
+    
+private:
+    bool reuse_cached(AnimationContext& ctx) {
+        if(!ctx.output || !unchanged()) return false;
+        PoseBuffer& out = *ctx.output;
+        const bool own_output = is_idempotent() && out.version == cache.pose.version;
+        if(out.version != cache.input_pose && !own_output) return false;
+        if(cache.parameters != ctx.parameter_version) return false;
+        if(cache.pose.bone_count != out.bone_count) return false;
+        
+        std::copy(cache.pose.rotation_z.begin(), cache.pose.rotation_z.end(), out.rotation_z.begin());
+        out.version = cache.pose.version;
+        return true;
+    }
 };
 
 } // namespace aino_animation
@@ -5,6 +5,7 @@
 #pragma once
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <immintrin.h>
 
 namespace aino_math {
@@ -19,6 +20,10 @@ struct Vec3 {
     Vec3 operator-(const Vec3& v) const { return {x-v.x, y-v.y, z-v.z}; }
     Vec3 operator*(float s) const { return {x*s, y*s, z*s}; }
     Vec3& operator+=(const Vec3& v) { x+=v.x; y+=v.y; z+=v.z; return *this; }
+    
+    // 分量下标访问（0=x, 1=y, 2=z）
+    float& operator[](int i) { return i == 0 ? x : (i == 1 ? y : z); }
+    float operator[](int i) const { return i == 0 ? x : (i == 1 ? y : z); }
 };
 
 // 叉积 (正确顺序：a × b)
@@ -35,6 +40,21 @@ inline float dot(const Vec3& a, const Vec3& b) {
     return a.x*b.x + a.y*b.y + a.z*b.z;
 }
 
+// 均匀网格空间哈希：格子坐标按轴 floor(v / cell)，三轴各21位打包为64位键
+struct GridHash {
+    float cell_size = 5.0f;
+    
+    [[nodiscard]] int coord(float v) const { return (int)std::floor(v / cell_size); }
+    
+    static uint64_t pack(int x, int y, int z) {
+        constexpr int64_t BIAS = 1 << 20;
+        constexpr uint64_t MASK = (1ull << 21) - 1;
+        return (uint64_t(x + BIAS) & MASK) << 42 | (uint64_t(y + BIAS) & MASK) << 21 | (uint64_t(z + BIAS) & MASK);
+    }
+    
+    [[nodiscard]] uint64_t key(const Vec3& p) const { return pack(coord(p.x), coord(p.y), coord(p.z)); }
+};
+
 // 四元数
 struct alignas(16) Quaternion {
     float x, y, z, w;
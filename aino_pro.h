@@ -9,25 +9,31 @@
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <array>
+#include <chrono>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "aino_animation.hpp"
 #include "aino_math.hpp"
+#include "profiler.hpp"
+#include "perf_counters.hpp"
+#include "biology/muscle_huxley.hpp"
+#include "systems/data_recorder.hpp"
+#include "systems/metrics.hpp"
 
-// 前向声明
 namespace aino_pro {
-namespace biology {
-    class Muscle;
-    class MuscleSystem;
-}
-namespace systems {
-    class DataRecorder;
-}
 
 // 精度级别
 enum class Accuracy {
     Realtime,    // 简化Hill模型
     Standard,    // 完整Huxley横桥模型
     High,        // 子步细分 + 肌腱滞后
-    Extreme      // 全网格计算
+    Extreme,     // 全网格计算
+    Surrogate    // 神经代理模型（背景人群）
 };
 
 // 功能开关
@@ -40,10 +46,28 @@ struct FeatureFlags {
     bool enable_thermal = false;
 };
 
+// 编译期流水线功能位（与FeatureFlags对应，thermal不参与流水线）
+enum FeatureBits : uint32_t {
+    FEATURE_METABOLISM = 1u << 0,
+    FEATURE_EMOTION    = 1u << 1,
+    FEATURE_NEURAL     = 1u << 2,
+    FEATURE_HYSTERESIS = 1u << 3,
+    FEATURE_FATIGUE    = 1u << 4,
+    FEATURE_ALL        = (1u << 5) - 1
+};
+
+constexpr uint32_t feature_mask(const FeatureFlags& f) {
+    return (f.enable_metabolism ? FEATURE_METABOLISM : 0u) |
+           (f.enable_emotion ? FEATURE_EMOTION : 0u) |
+           (f.enable_neural ? FEATURE_NEURAL : 0u) |
+           (f.enable_hysteresis ? FEATURE_HYSTERESIS : 0u) |
+           (f.enable_fatigue ? FEATURE_FATIGUE : 0u);
+}
+
 // 性能预算
 struct PerformanceBudget {
     float cpu_ms_per_frame = 3.0f;
-    float muscle_update_ratio = 1.0f;
+    float muscle_update_ratio = 1.0f;   // 肌肉阶段可用的帧预算比例（超时保留廉价估计）
     int max_muscle_grids = 100;
 };
 
@@ -65,48 +89,339 @@ struct Config {
     static Config load(const std::string& path);
 };
 
-// 全局引擎（线程安全单例）
+// 上下文内所有肌肉的注册表（注册/遍历在帧边界进行）
+class MuscleRegistry {
+    struct Entry {
+        const void* owner;
+        std::vector<biology::Muscle>* muscles;
+    };
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    
+public:
+    void add(const void* owner, std::vector<biology::Muscle>* muscles) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back({owner, muscles});
+    }
+    
+    void remove(const void* owner) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                      [&](const Entry& e) { return e.owner == owner; }), entries.end());
+    }
+    
+    [[nodiscard]] size_t muscle_count() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = 0;
+        for(const auto& e : entries) count += e.muscles->size();
+        return count;
+    }
+    
+    template<typename Fn>
+    void for_each(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& e : entries) {
+            for(auto& m : *e.muscles) fn(m);
+        }
+    }
+    
+    // 强制统一网格（工具/测试用；运行时由各角色LOD自行同步）
+    void reconfigure_all(int grid_size) {
+        for_each([&](biology::Muscle& m) { m.set_grid_size(grid_size); });
+    }
+};
+
+// 帧性能概况：角色在帧末无锁累加，end_frame() 时成为上一帧结果
+struct FrameProfile {
+    float last_frame_ms = 0.0f;         // 全部角色CPU时间之和
+    size_t active_muscles = 0;          // 完成Huxley精算的肌肉数
+    size_t actors = 0;                  // 本帧完成评估的角色数
+    bool is_thermal_throttling = false;
+};
+
+struct ContextOptions {
+    bool enable_recorder = true;
+    unsigned thread_budget = 0;  // 0 = 硬件线程数
+};
+
+// 线程预算作用域：限制调用线程此后发起的 OpenMP 并行区（含肌肉 / 脊髓 / 骨骼内部的区域），
+// 析构时恢复调用方原设置
+class ThreadBudgetScope {
+#ifdef _OPENMP
+    const int previous;
+    
+public:
+    explicit ThreadBudgetScope(unsigned threads) : previous(omp_get_max_threads()) {
+        omp_set_num_threads((int)std::max(threads, 1u));
+    }
+    ~ThreadBudgetScope() { omp_set_num_threads(previous); }
+#else
+public:
+    explicit ThreadBudgetScope(unsigned) {}
+#endif
+
+    ThreadBudgetScope(const ThreadBudgetScope&) = delete;
+    ThreadBudgetScope& operator=(const ThreadBudgetScope&) = delete;
+};
+
+// 独立引擎上下文：配置快照、记录器、线程预算、肌肉注册表
+// 同一进程可并存多个（游戏世界 / 离线数据生成 / 测试）
+// 配置以不可变快照发布（RCU）：工作线程无锁读取，修改在帧边界统一发布
+class EngineContext {
+    std::shared_ptr<const Config> config;   // 当前快照（仅经 atomic_load/store 访问）
+    std::shared_ptr<const Config> pending;  // 待发布快照（受 pending_mutex 保护）
+    std::mutex pending_mutex;
+    std::atomic<uint64_t> epoch{0};
+    
+    std::unique_ptr<systems::DataRecorder> recorder_owner;
+    std::atomic<systems::DataRecorder*> recorder{nullptr};
+    std::atomic<unsigned> thread_budget{0};
+    std::atomic<int64_t> world_frame_start{0};   // steady_clock 计数；0 = 未开始世界帧
+    MuscleRegistry muscle_registry;
+    const uint64_t context_id;
+    
+    // 帧性能累加（当前帧 / 上一帧），任意线程读写
+    struct ProfileCounters {
+        std::atomic<uint64_t> frame_us{0};
+        std::atomic<uint64_t> muscles{0};
+        std::atomic<uint64_t> actors{0};
+        std::atomic<bool> throttling{false};
+    } frame_counters, last_counters;
+    
+    // 指标注册表（默认关闭）；帧级指标在构造时注册，end_frame 无查找
+    systems::MetricsRegistry metrics_registry;
+    struct FrameMetrics {
+        systems::Counter* frames;
+        systems::Gauge* cpu_ms;
+        systems::Gauge* active_muscles;
+        systems::Gauge* actors;
+        systems::LatencyHistogram* cpu_latency;
+    } frame_metrics;
+    
+    // 每线程快照缓存：epoch 未变时只需一次原子读（按上下文ID区分）
+    struct SnapshotCache {
+        uint64_t context = 0;
+        uint64_t epoch = ~0ull;
+        std::shared_ptr<const Config> config;
+    };
+    static constexpr size_t CACHE_SLOTS = 4;
+    
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+    
+public:
+    explicit EngineContext(const Config& cfg = Config(), const ContextOptions& opt = ContextOptions())
+        : config(std::make_shared<const Config>(cfg)), context_id(next_id()) {
+        frame_metrics = {&metrics_registry.counter("frames"), &metrics_registry.gauge("frame.cpu_ms"),
+                         &metrics_registry.gauge("frame.active_muscles"), &metrics_registry.gauge("frame.actors"),
+                         &metrics_registry.histogram("frame.cpu")};
+        if(opt.enable_recorder) enable_recorder();
+        set_thread_budget(opt.thread_budget);
+    }
+    
+    EngineContext(const EngineContext&) = delete;
+    EngineContext& operator=(const EngineContext&) = delete;
+    
+    void enable_recorder() {
+        if(recorder_owner) return;
+        recorder_owner = std::make_unique<systems::DataRecorder>();
+        recorder.store(recorder_owner.get(), std::memory_order_release);
+    }
+    
+    // 暂存新配置，下一次 publish_pending() 时生效
+    void update_config(const Config& cfg) {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending = std::make_shared<const Config>(cfg);
+    }
+    
+    void set_accuracy(Accuracy acc) {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        Config next = pending ? *pending : *std::atomic_load(&config);
+        next.accuracy = acc;
+        pending = std::make_shared<const Config>(next);
+    }
+    
+    // 帧边界调用（模拟线程）：发布暂存的配置快照
+    bool publish_pending() {
+        std::shared_ptr<const Config> next;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            next.swap(pending);
+        }
+        if(!next) return false;
+        publish(std::move(next));
+        return true;
+    }
+    
+    // 当前配置快照（引用计数保活，可跨帧 / 跨发布点持有）
+    // 每线程缓存按上下文ID区分：epoch 未变时不经 atomic_load，只做一次引用计数递增；
+    // 槽位被淘汰只释放缓存自身的引用，不影响调用方持有的快照
+    [[nodiscard]] std::shared_ptr<const Config> get_config() const {
+        thread_local std::array<SnapshotCache, CACHE_SLOTS> t_cache;
+        thread_local size_t t_next_slot = 0;
+        
+        uint64_t current = epoch.load(std::memory_order_acquire);
+        for(auto& slot : t_cache) {
+            if(slot.context == context_id) {
+                if(slot.epoch != current) {
+                    slot.config = std::atomic_load(&config);
+                    slot.epoch = current;
+                }
+                return slot.config;
+            }
+        }
+        
+        auto& slot = t_cache[t_next_slot++ % CACHE_SLOTS];
+        slot.context = context_id;
+        slot.config = std::atomic_load(&config);
+        slot.epoch = current;
+        return slot.config;
+    }
+    
+    [[nodiscard]] systems::DataRecorder* get_recorder() const {
+        return recorder.load(std::memory_order_acquire);
+    }
+    
+    void set_thread_budget(unsigned threads) {
+        thread_budget.store(threads ? threads : std::max(1u, std::thread::hardware_concurrency()),
+                            std::memory_order_relaxed);
+    }
+    [[nodiscard]] unsigned get_thread_budget() const {
+        return thread_budget.load(std::memory_order_relaxed);
+    }
+    
+    // 角色帧末调用（可并发）
+    void report_frame(float cpu_ms, size_t active_muscles, bool throttling) {
+        frame_counters.frame_us.fetch_add(uint64_t(cpu_ms * 1000.0f), std::memory_order_relaxed);
+        frame_counters.muscles.fetch_add(active_muscles, std::memory_order_relaxed);
+        frame_counters.actors.fetch_add(1, std::memory_order_relaxed);
+        if(throttling) frame_counters.throttling.store(true, std::memory_order_relaxed);
+    }
+    
+    // 世界帧开始（模拟线程，角色更新前调用）：本帧所有角色共享同一截止时间
+    void begin_frame() {
+        world_frame_start.store(std::chrono::steady_clock::now().time_since_epoch().count(),
+                                std::memory_order_release);
+    }
+    
+    // 阶段截止时间 = 世界帧起点 + 阶段预算；未调用 begin_frame 时以调用方给出的起点计（独立角色）
+    [[nodiscard]] std::chrono::steady_clock::time_point frame_deadline(
+            float budget_ms, std::chrono::steady_clock::time_point fallback_start) const {
+        using clock = std::chrono::steady_clock;
+        const int64_t start = world_frame_start.load(std::memory_order_acquire);
+        const clock::time_point origin = start ? clock::time_point(clock::duration(start)) : fallback_start;
+        return origin + std::chrono::microseconds((long long)(budget_ms * 1000.0f));
+    }
+    
+    // 角色预算份额：整帧预算按上一帧评估的角色数均分（超预算日志按角色归因）
+    [[nodiscard]] float actor_budget_ms(float frame_budget_ms) const {
+        return frame_budget_ms / float(std::max<uint64_t>(last_counters.actors.load(std::memory_order_relaxed), 1));
+    }
+    
+    // 帧边界调用（模拟线程）：翻转性能概况并发布暂存配置，结束当前世界帧
+    //   调用过 begin_frame 时，整帧墙钟时间对照 cpu_ms_per_frame 记录一次
+    bool end_frame() {
+        const int64_t world_start = world_frame_start.exchange(0, std::memory_order_relaxed);
+        last_counters.frame_us.store(frame_counters.frame_us.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        last_counters.muscles.store(frame_counters.muscles.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        last_counters.actors.store(frame_counters.actors.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        last_counters.throttling.store(frame_counters.throttling.exchange(false, std::memory_order_relaxed), std::memory_order_relaxed);
+        
+        if(metrics_registry.is_enabled()) {
+            const FrameProfile p = get_profile();
+            frame_metrics.frames->add();
+            frame_metrics.cpu_ms->set(p.last_frame_ms);
+            frame_metrics.active_muscles->set(double(p.active_muscles));
+            frame_metrics.actors->set(double(p.actors));
+            frame_metrics.cpu_latency->record_ms(p.last_frame_ms);
+            if(world_start) {
+                using clock = std::chrono::steady_clock;
+                const float world_ms = std::chrono::duration<float, std::milli>(
+                    clock::now() - clock::time_point(clock::duration(world_start))).count();
+                metrics_registry.record_world_frame(world_ms, get_config()->budget.cpu_ms_per_frame);
+            }
+        }
+        return publish_pending();
+    }
+    
+    // 上一帧概况（任意线程，不暂停模拟）
+    [[nodiscard]] FrameProfile get_profile() const {
+        FrameProfile p;
+        p.last_frame_ms = last_counters.frame_us.load(std::memory_order_relaxed) * 1e-3f;
+        p.active_muscles = (size_t)last_counters.muscles.load(std::memory_order_relaxed);
+        p.actors = (size_t)last_counters.actors.load(std::memory_order_relaxed);
+        p.is_thermal_throttling = last_counters.throttling.load(std::memory_order_relaxed);
+        return p;
+    }
+    
+    [[nodiscard]] MuscleRegistry& muscles() { return muscle_registry; }
+    [[nodiscard]] systems::MetricsRegistry& metrics() { return metrics_registry; }
+    [[nodiscard]] const systems::MetricsRegistry& metrics() const { return metrics_registry; }
+    [[nodiscard]] uint64_t id() const { return context_id; }
+    
+private:
+    void publish(std::shared_ptr<const Config> next) {
+        std::atomic_store(&config, std::move(next));
+        epoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+};
+
+// 全局引擎（默认上下文的静态外观，兼容旧接口）
 class Engine {
-    static thread_local Config t_config;
-    static thread_local std::unique_ptr<systems::DataRecorder> t_recorder;
-    static std::atomic<bool> s_initialized;
+    static inline std::atomic<bool> s_initialized{false};
     
 public:
+    static EngineContext& default_context() {
+        static EngineContext ctx(Config(), ContextOptions{false, 0});
+        return ctx;
+    }
+    
     static void initialize(const Config& cfg) {
         if(s_initialized.exchange(true)) return; // 防止重复初始化
         
-        t_config = cfg;
-        t_recorder = std::make_unique<systems::DataRecorder>();
-        
-        // 根据精度配置肌肉网格
-        biology::Muscle::set_global_grid_size(
-            cfg.accuracy == Accuracy::Realtime ? 10 :
-            cfg.accuracy == Accuracy::Standard ? 100 :
-            cfg.accuracy == Accuracy::High ? 200 : 1000
-        );
+        auto& ctx = default_context();
+        ctx.enable_recorder();
+        ctx.update_config(cfg);
+        ctx.publish_pending();
     }
     
-    static void set_accuracy(Accuracy acc) {
-        t_config.accuracy = acc;
-        biology::MuscleSystem::reconfigure_all();
+    static void update_config(const Config& cfg) { default_context().update_config(cfg); }
+    
+    // 各角色在下一帧按新精度重设自己肌肉的网格（无全局可变状态）
+    static void set_accuracy(Accuracy acc) { default_context().set_accuracy(acc); }
+    
+    static bool publish_pending() { return default_context().publish_pending(); }
+    
+    static void begin_frame() { default_context().begin_frame(); }
+    static bool end_frame() { return default_context().end_frame(); }
+    
+    // 精度 → 默认Huxley网格大小（角色LOD可覆盖）
+    [[nodiscard]] static constexpr int grid_size_for(Accuracy acc) {
+        return acc == Accuracy::Realtime ? 10 :
+               acc == Accuracy::Surrogate ? 10 :
+               acc == Accuracy::Standard ? 100 :
+               acc == Accuracy::High ? 200 : 1000;
     }
     
     [[nodiscard]] static systems::DataRecorder* get_recorder() { 
-        return t_recorder ? t_recorder.get() : nullptr; 
+        return default_context().get_recorder();
     }
     
-    [[nodiscard]] static Config& get_config() { return t_config; }
+    [[nodiscard]] static std::shared_ptr<const Config> get_config() { return default_context().get_config(); }
+    
+    using Profile = FrameProfile;
+    
+    // 默认上下文上一帧概况；分阶段/分内核耗时见 Profiler（AINO_PROFILE）
+    [[nodiscard]] static Profile get_profile() { return default_context().get_profile(); }
+    [[nodiscard]] static systems::MetricsRegistry& metrics() { return default_context().metrics(); }
     
-    struct Profile {
-        float last_frame_ms = 0.0f;
-        size_t active_muscles = 0;
-        bool is_thermal_throttling = false;
-    } profile;
+    // 硬件计数器：按线程、按流水线阶段累计（槽位 = PipelineStage），不可用时见 get_status()
+    static void set_hardware_counters(bool enabled) { HardwareCounters::instance().set_enabled(enabled); }
+    [[nodiscard]] static std::vector<ThreadCounterProfile> get_counter_profile() {
+        return HardwareCounters::instance().snapshot();
+    }
 };
 
-// 静态成员定义
-thread_local Config Engine::t_config;
-thread_local std::unique_ptr<systems::DataRecorder> Engine::t_recorder;
-std::atomic<bool> Engine::s_initialized{false};
-
 } // namespace aino_pro
@@ -0,0 +1,232 @@
+// =====================================================
+// aino_pro/systems/batch_runner.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include "../aino_pro.hpp"
+#include "physiological_actor.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 刺激时间线条目：[start, end) 内持续作用
+struct StimulusEvent {
+    double start = 0.0;
+    double end = 0.0;
+    psychology::Stimulus stimulus;
+};
+
+// 扭矩关键帧轨道（线性插值，超出范围取端点）
+struct TorqueTrack {
+    std::vector<double> times;
+    std::vector<std::vector<float>> torques; // 每关键帧每关节
+    
+    void sample(double t, std::vector<float>& out) const {
+        out.clear();
+        if(times.empty()) return;
+        auto it = std::upper_bound(times.begin(), times.end(), t);
+        if(it == times.begin()) { out = torques.front(); return; }
+        if(it == times.end()) { out = torques.back(); return; }
+        
+        size_t i1 = it - times.begin(), i0 = i1 - 1;
+        float w = float((t - times[i0]) / (times[i1] - times[i0]));
+        const auto& a = torques[i0];
+        const auto& b = torques[i1];
+        out.resize(std::min(a.size(), b.size()));
+        for(size_t j = 0; j < out.size(); ++j) out[j] = a[j] + (b[j] - a[j]) * w;
+    }
+};
+
+// 单个无头仿真场景
+struct Scenario {
+    std::string name;
+    Config config;                  // 含 HumanParams 变体
+    double duration = 10.0;         // 仿真时长 [s]
+    float dt = 1.0f / 60.0f;
+    size_t muscle_count = 50;
+    std::vector<StimulusEvent> stimuli;
+    TorqueTrack torques;
+    
+    // t 时刻的驱动输入（复用 input 的缓冲）
+    void input_at(double t, PhysioBridge& input) const {
+        input.cognitive_stimuli.clear();
+        for(const auto& ev : stimuli) {
+            if(t >= ev.start && t < ev.end) input.cognitive_stimuli.push_back(ev.stimulus);
+        }
+        torques.sample(t, input.desired_joint_torques);
+    }
+};
+
+struct BatchProgress {
+    size_t scenarios_done = 0;
+    size_t scenarios_total = 0;
+    size_t frames = 0;
+    double wall_seconds = 0.0;
+    double frames_per_second = 0.0;
+    double realtime_factor = 0.0;   // 仿真秒 / 墙钟秒
+};
+
+struct BatchOptions {
+    unsigned threads = 0;                   // 0 = 硬件线程数
+    std::string output_pattern;             // 如 "dataset_{worker}.h5"；空 = 不写盘
+    bool capture_in_memory = false;         // 保留样本供 SurrogateTrainer
+    double progress_interval = 1.0;         // [s]
+    std::function<void(const BatchProgress&)> on_progress;
+};
+
+struct BatchResult {
+    BatchProgress summary;
+    std::vector<std::string> outputs;                    // 每工作线程一个文件
+    std::vector<std::vector<TrainingSample>> captured;   // capture_in_memory 时填充
+};
+
+// 无头批量仿真：场景按原子计数分发到各工作线程，每线程独立上下文与记录器
+class BatchRunner {
+public:
+    static BatchResult run(const std::vector<Scenario>& scenarios, const BatchOptions& opt = {}) {
+        const unsigned worker_count = std::max(1u, std::min<unsigned>(
+            opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency()),
+            (unsigned)std::max<size_t>(scenarios.size(), 1)));
+        
+        BatchResult result;
+        result.outputs.resize(worker_count);
+        result.captured.resize(worker_count);
+        
+        Shared shared;
+        shared.running = worker_count;
+        std::vector<std::exception_ptr> errors(worker_count);
+        auto start = std::chrono::steady_clock::now();
+        
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for(unsigned w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&, w] {
+                try {
+                    run_worker(w, scenarios, opt, shared, result);
+                } catch(...) {
+                    errors[w] = std::current_exception();
+                }
+                --shared.running;
+            });
+        }
+        
+        // 主线程：定期汇报进度
+        auto progress = [&]() {
+            BatchProgress p;
+            p.scenarios_done = shared.done.load();
+            p.scenarios_total = scenarios.size();
+            p.frames = shared.frames.load();
+            p.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if(p.wall_seconds > 0.0) {
+                p.frames_per_second = p.frames / p.wall_seconds;
+                p.realtime_factor = shared.sim_seconds.load() / p.wall_seconds;
+            }
+            return p;
+        };
+        
+        if(opt.on_progress) {
+            auto interval = std::chrono::duration<double>(std::max(opt.progress_interval, 0.01));
+            auto next_report = std::chrono::steady_clock::now() + interval;
+            while(shared.running.load() > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                if(std::chrono::steady_clock::now() >= next_report) {
+                    opt.on_progress(progress());
+                    next_report += std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+                }
+            }
+        }
+        
+        for(auto& t : workers) t.join();
+        for(auto& e : errors) {
+            if(e) std::rethrow_exception(e);
+        }
+        result.summary = progress();
+        if(opt.on_progress) opt.on_progress(result.summary);
+        return result;
+    }
+    
+private:
+    // 工作线程共享计数
+    struct Shared {
+        std::atomic<size_t> next_scenario{0};
+        std::atomic<size_t> done{0};
+        std::atomic<size_t> frames{0};
+        std::atomic<double> sim_seconds{0.0};
+        std::atomic<unsigned> running{0};
+    };
+    
+    static void run_worker(unsigned w, const std::vector<Scenario>& scenarios,
+                           const BatchOptions& opt, Shared& shared, BatchResult& result) {
+        // 每线程独立上下文：配置、记录器互不干扰
+        ContextOptions ctx_opt;
+        ctx_opt.enable_recorder = !opt.output_pattern.empty() || opt.capture_in_memory;
+        ctx_opt.thread_budget = 1;
+        EngineContext ctx(Config(), ctx_opt);
+        
+        // N 个工作线程各自发起的 OpenMP 并行区也只用预算内线程，避免 N × 核数超订
+        const ThreadBudgetScope budget(ctx.get_thread_budget());
+        
+        if(auto* recorder = ctx.get_recorder()) {
+            if(!opt.output_pattern.empty()) {
+                result.outputs[w] = format_output(opt.output_pattern, w);
+                recorder->start_session(result.outputs[w]);
+            }
+            recorder->enable_capture(opt.capture_in_memory);
+        }
+        
+        for(size_t i = shared.next_scenario++; i < scenarios.size(); i = shared.next_scenario++) {
+            shared.frames += run_scenario(ctx, scenarios[i]);
+            add(shared.sim_seconds, scenarios[i].duration);
+            ++shared.done;
+        }
+        
+        if(auto* recorder = ctx.get_recorder()) {
+            if(opt.capture_in_memory) result.captured[w] = recorder->get_captured();
+        }
+    }
+    
+    // 返回仿真帧数
+    static size_t run_scenario(EngineContext& ctx, const Scenario& sc) {
+        ctx.update_config(sc.config);
+        ctx.publish_pending();
+        
+        PhysiologicalActor actor(sc.muscle_count, &ctx);
+        PhysioBridge input;
+        const size_t frame_count = (size_t)std::ceil(sc.duration / sc.dt);
+        
+        for(size_t f = 0; f < frame_count; ++f) {
+            sc.input_at(f * (double)sc.dt, input);
+            actor.update(sc.dt, input);
+        }
+        return frame_count;
+    }
+    
+    static std::string format_output(const std::string& pattern, unsigned worker) {
+        std::string out = pattern;
+        auto pos = out.find("{worker}");
+        if(pos != std::string::npos) {
+            out.replace(pos, 8, std::to_string(worker));
+        } else {
+            out += "." + std::to_string(worker);
+        }
+        return out;
+    }
+    
+    static void add(std::atomic<double>& target, double value) {
+        double current = target.load();
+        while(!target.compare_exchange_weak(current, current + value)) {}
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -0,0 +1,281 @@
+// =====================================================
+// bench/aino_bench.cpp - 内核微基准 / 整帧基准 / 差分验证
+// 用法：aino_bench [--suite kernels|frames|validate|all] [--filter 名称子串] [--json 输出文件]
+//                  [--samples N] [--min-time-ms T] [--actors 1,10,100] [--threads 1,4]
+//                  [--frame-seconds S] [--max-config-seconds S] [--validate-seconds S] [--quick]
+//                  [--trace trace.json]（整帧基准的计时区，Chrome Trace 格式）
+//                  [--hw-counters]（整帧基准按阶段采集 perf_event 计数器，不可用时记录原因）
+//                  [--metrics]（整帧基准输出指标快照：每LOD档位×阶段延迟直方图、超预算日志）
+// 差分验证超出容差时返回 2
+// =====================================================
+
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include "aino_pro/aino_pro.hpp"
+#include "aino_pro/biology/muscle_huxley.hpp"
+#include "aino_pro/biology/tendon_viscoelastic.hpp"
+#include "aino_pro/biology/metabolism.hpp"
+#include "aino_pro/biology/multibody.hpp"
+#include "aino_pro/neuroscience/spinal_circuit.hpp"
+#include "aino_pro/psychology/cognitive_appraisal.hpp"
+#include "bench_harness.hpp"
+#include "frame_bench.hpp"
+#include "validate.hpp"
+
+using namespace aino_pro;
+
+namespace {
+
+// 输入缓慢变化，避免常量折叠且不触发分支预测的极端情况
+struct Wave {
+    float phase = 0.0f;
+    float next(float step = 0.01f) {
+        phase += step;
+        if(phase > 6.2831853f) phase -= 6.2831853f;
+        return 0.5f + 0.5f * std::sin(phase);
+    }
+};
+
+void bench_huxley(aino_bench::KernelRunner& runner) {
+    // 所有特化网格 + Extreme 精度网格；元素 = 网格点
+    std::vector<int> grids(biology::HuxleyFiber::SPECIALIZED_GRID_SIZES.begin(),
+                           biology::HuxleyFiber::SPECIALIZED_GRID_SIZES.end());
+    grids.push_back(Engine::grid_size_for(Accuracy::Extreme));
+    
+    for(int grid : grids) {
+        biology::HuxleyFiber fiber(grid);
+        Wave wave;
+        runner.run("huxley_fiber.step/grid=" + std::to_string(grid), grid, [&] {
+            float a = wave.next();
+            fiber.step(a, 1.0f, (a - 0.5f) * 100.0f, 0.001f);
+            aino_bench::do_not_optimize(fiber);
+        });
+    }
+}
+
+void bench_motor_neuron_pool(aino_bench::KernelRunner& runner) {
+    // 元素 = 池内神经元（100个）
+    neuroscience::MotorNeuronPool pool;
+    Wave wave;
+    runner.run("motor_neuron_pool.step", 100, [&] {
+        pool.set_central_drive(wave.next());
+        pool.set_spindle_feedback(wave.phase * 0.05f);
+        pool.step(0.001f);
+        aino_bench::do_not_optimize(pool);
+    });
+}
+
+void bench_tendon(aino_bench::KernelRunner& runner) {
+    biology::TendonNonlinear tendon;
+    Wave wave;
+    runner.run("tendon_nonlinear.compute_stress", 1, [&] {
+        float strain = 0.05f * wave.next();
+        float stress = tendon.compute_stress(strain, strain * 10.0f, 0.001f);
+        aino_bench::do_not_optimize(stress);
+    });
+}
+
+void bench_metabolism(aino_bench::KernelRunner& runner) {
+    biology::MetabolicSystem metabolism;
+    Wave wave;
+    runner.run("metabolic_system.update", 1, [&] {
+        metabolism.update(wave.next(), 0.004f);
+        aino_bench::do_not_optimize(metabolism);
+    });
+}
+
+void bench_skeleton(aino_bench::KernelRunner& runner) {
+    // 元素 = 关节
+    biology::ArticulatedSkeleton skeleton;
+    aino_animation::PoseBuffer pose(skeleton.joint_count());
+    Wave wave;
+    runner.run("articulated_skeleton.write_to_pose_buffer", (double)skeleton.joint_count(), [&] {
+        skeleton.set_joint_rotation_z(0, wave.next());
+        skeleton.write_to_pose_buffer(pose);
+        aino_bench::do_not_optimize(pose.rotation_z.data());
+    });
+}
+
+void bench_appraisal(aino_bench::KernelRunner& runner) {
+    psychology::CognitiveAppraiser appraiser;
+    aino_animation::AnimationContext ctx;
+    ctx.parameters["self_efficacy"] = 0.7f;
+    ctx.parameters["self_esteem"] = 0.8f;
+    
+    static const char* CATEGORIES[] = {"threat", "reward", "loss", "enemy", "friend", "noise"};
+    std::vector<psychology::Stimulus> stimuli;
+    Wave wave;
+    for(int i = 0; i < 64; ++i) {
+        psychology::Stimulus s;
+        s.set_category(CATEGORIES[i % 6]);
+        s.intensity = wave.next(0.37f);
+        s.urgency = wave.next(0.53f);
+        s.familiarity = wave.next(0.11f);
+        s.predictability = wave.next(0.29f);
+        s.id = uint32_t(i + 1);
+        stimuli.push_back(s);
+    }
+    
+    size_t k = 0;
+    runner.run("cognitive_appraiser.appraise", 1, [&] {
+        auto out = appraiser.appraise(stimuli[k++ & 63], ctx);
+        aino_bench::do_not_optimize(out);
+    });
+    
+    // SoA批量路径（元素 = 刺激）
+    psychology::StimulusBatch batch;
+    batch.assign(stimuli);
+    psychology::AppraisalTraits traits{0.7f, 0.8f, 0.1f};
+    runner.run("cognitive_appraiser.appraise_batch/n=64", (double)batch.size(), [&] {
+        psychology::EmotionProfile out;
+        appraiser.appraise_batch(batch, traits, out);
+        aino_bench::do_not_optimize(out);
+    });
+    
+    // 广播评估（元素 = 角色）：200m 见方散布，64个事件，网格剔除
+    const size_t actors = 1000;
+    psychology::CrowdAppraisal crowd;
+    crowd.resize(actors);
+    for(size_t i = 0; i < actors; ++i) {
+        crowd.set_actor(i, {wave.next(0.71f) * 200.0f - 100.0f, 0.0f, wave.next(0.43f) * 200.0f - 100.0f}, traits);
+    }
+    std::vector<psychology::BroadcastStimulus> events;
+    for(size_t i = 0; i < stimuli.size(); ++i) {
+        stimuli[i].position = {wave.next(0.61f) * 200.0f - 100.0f, 0.0f, wave.next(0.37f) * 200.0f - 100.0f};
+        events.push_back(psychology::BroadcastStimulus::prepare(stimuli[i], 15.0f));
+    }
+    runner.run("cognitive_appraiser.appraise_broadcast/events=64", (double)actors, [&] {
+        crowd.clear_output();
+        appraiser.appraise_broadcast(events.data(), events.size(), crowd);
+        aino_bench::do_not_optimize(crowd.fear.data());
+    });
+}
+
+void bench_metrics(aino_bench::KernelRunner& runner) {
+    // 热路径记录开销（单线程，无竞争）
+    systems::LatencyHistogram histogram;
+    uint64_t ns = 1000;
+    runner.run("metrics.histogram.record", 1, [&] {
+        ns = ns * 6364136223846793005ull + 1442695040888963407ull;
+        histogram.record((ns >> 40) & 0xFFFFFF);
+    });
+    
+    systems::MetricsRegistry registry;
+    std::array<float, systems::STAGE_COUNT> stage_ms{};
+    Wave wave;
+    runner.run("metrics.record_actor_frame", 1, [&] {
+        for(auto& s : stage_ms) s = wave.next(0.1f);
+        registry.record_actor_frame(1, 0, stage_ms.data(), 2.9f + wave.phase * 0.02f, 3.0f);
+    });
+}
+
+#if AINO_PROFILE
+void bench_profiler(aino_bench::KernelRunner& runner) {
+    // 时钟读取下限：独立计时区读两次，相邻计时区链每区读一次
+    runner.run("profiler.ticks", 1, [] {
+        uint64_t t = profile_ticks();
+        aino_bench::do_not_optimize(t);
+    });
+    
+    // 单个计时区 / 相邻计时区链每区开销（运行时开启 / 关闭）
+    auto& profiler = Profiler::instance();
+    const bool was_enabled = profiler.is_enabled();
+    for(bool on : {true, false}) {
+        profiler.set_enabled(on);
+        runner.run(on ? "profiler.zone" : "profiler.zone/disabled", 1, [] {
+            AINO_ZONE("bench.zone");
+        });
+        ZoneChain chain;
+        chain.begin();
+        runner.run(on ? "profiler.zone_chain" : "profiler.zone_chain/disabled", 1, [&] {
+            chain.lap("bench.chain");
+        });
+    }
+    profiler.set_enabled(was_enabled);
+    profiler.clear();
+}
+#endif
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto opt = aino_bench::Options::parse(argc, argv);
+        aino_bench::KernelRunner kernels(opt);
+        aino_bench::FrameRunner frames(opt);
+        aino_bench::Validator validator(opt);
+        
+        if(opt.runs("kernels")) {
+            bench_huxley(kernels);
+            bench_motor_neuron_pool(kernels);
+            bench_tendon(kernels);
+            bench_metabolism(kernels);
+            bench_skeleton(kernels);
+            bench_appraisal(kernels);
+            bench_metrics(kernels);
+#if AINO_PROFILE
+            bench_profiler(kernels);
+#endif
+        }
+        
+        const bool tracing = !opt.trace_path.empty() && opt.runs("frames");
+        if(tracing) {
+#if AINO_PROFILE
+            Profiler::instance().set_ring_capacity(size_t(1) << 20);
+            Profiler::instance().clear();
+            Profiler::instance().set_enabled(true);
+#else
+            throw std::runtime_error("--trace requires a build with AINO_PROFILE=1");
+#endif
+        }
+        if(opt.runs("frames")) frames.run_all();
+        if(tracing) {
+            Profiler::instance().set_enabled(false);
+            std::ofstream trace(opt.trace_path);
+            if(!trace) throw std::runtime_error("Failed to open " + opt.trace_path);
+            Profiler::instance().write_chrome_trace(trace);
+        }
+        if(opt.runs("validate")) validator.run_all();
+        
+        std::ofstream file;
+        if(!opt.json_path.empty()) {
+            file.open(opt.json_path);
+            if(!file) throw std::runtime_error("Failed to open " + opt.json_path);
+        }
+        std::ostream& os = opt.json_path.empty() ? std::cout : file;
+        os << "{\n  \"schema\": \"aino_bench/1\",\n  \"hardware_threads\": " << std::thread::hardware_concurrency()
+           << ",\n  \"kernels\": ";
+        kernels.write_json(os);
+        os << ",\n  \"frames\": ";
+        frames.write_json(os);
+        os << ",\n  \"hw_counters\": {\"enabled\": " << (opt.hw_counters ? "true" : "false");
+        if(opt.hw_counters) {
+            os << ", \"status\": \"" << aino_bench::json_escape(HardwareCounters::instance().get_status())
+               << "\", \"available\": [";
+            const uint32_t mask = HardwareCounters::instance().available();
+            bool first = true;
+            for(size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+                if(!((mask >> e) & 1u)) continue;
+                os << (first ? "" : ", ") << "\"" << hw_event_name(HwEvent(e)) << "\"";
+                first = false;
+            }
+            os << "]";
+        }
+        os << "}";
+        os << ",\n  \"zones\": ";
+        if(tracing) Profiler::instance().write_summary_json(os); else os << "[]";
+        os << ",\n  \"validation\": ";
+        validator.write_json(os);
+        os << "\n}\n";
+        
+        if(size_t failed = validator.failures()) {
+            std::cerr << "aino_bench: " << failed << " validation check(s) exceeded tolerance\n";
+            return 2;
+        }
+    } catch(const std::exception& e) {
+        std::cerr << "aino_bench: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
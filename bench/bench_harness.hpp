@@ -0,0 +1,241 @@
+// =====================================================
+// bench/bench_harness.hpp - 基准计时 / 统计 / JSON输出
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+
+namespace aino_bench {
+
+// 阻止编译器消除被测结果
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+struct Stats {
+    double mean = 0.0, median = 0.0, min = 0.0, max = 0.0;
+    double variance = 0.0, stddev = 0.0;
+    double p50 = 0.0, p99 = 0.0;
+    
+    static Stats of(std::vector<double> samples) {
+        Stats s;
+        if(samples.empty()) return s;
+        std::sort(samples.begin(), samples.end());
+        const size_t n = samples.size();
+        s.min = samples.front();
+        s.max = samples.back();
+        s.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+        s.median = n % 2 ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+        for(double v : samples) s.variance += (v - s.mean) * (v - s.mean);
+        s.variance = n > 1 ? s.variance / (n - 1) : 0.0;
+        s.stddev = std::sqrt(s.variance);
+        s.p50 = percentile(samples, 0.50);
+        s.p99 = percentile(samples, 0.99);
+        return s;
+    }
+    
+    // 已排序样本，最近秩
+    static double percentile(const std::vector<double>& sorted, double q) {
+        if(sorted.empty()) return 0.0;
+        size_t rank = (size_t)std::ceil(q * sorted.size());
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+};
+
+// JSON字符串转义（名称均为ASCII，仅处理引号/反斜杠/控制字符）
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    for(char c : s) {
+        if(c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if((unsigned char)c < 0x20) { char buf[8]; std::snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+        else out += c;
+    }
+    return out;
+}
+
+inline void write_stats(std::ostream& os, const Stats& s) {
+    os << "{\"mean\": " << s.mean << ", \"median\": " << s.median
+       << ", \"min\": " << s.min << ", \"max\": " << s.max
+       << ", \"variance\": " << s.variance << ", \"stddev\": " << s.stddev
+       << ", \"p50\": " << s.p50 << ", \"p99\": " << s.p99 << "}";
+}
+
+struct Options {
+    std::string suite = "all";      // kernels / frames / validate / all
+    std::string filter;             // 名称子串过滤
+    std::string json_path;          // 空 = 标准输出
+    std::string trace_path;         // 非空 = 整帧基准开启计时区并导出 Chrome Trace
+    bool hw_counters = false;       // 整帧基准按阶段采集硬件计数器
+    bool metrics = false;           // 整帧基准开启指标注册表并输出快照
+    int samples = 15;               // 每项采样次数
+    double min_sample_ms = 20.0;    // 单次采样最短时长（自动加倍迭代数）
+    
+    // 整帧基准
+    std::vector<size_t> actor_counts = {1, 10, 100, 1000};
+    std::vector<unsigned> threads;  // 空 = 1, 2, 4, ... ≤ 硬件线程数
+    double frame_seconds = 2.0;     // 每场景仿真时长 [s]
+    double max_config_seconds = 5.0; // 单配置墙钟上限（大规模配置提前截断）
+    
+    // 差分验证
+    double validate_seconds = 20.0; // 每项对照的仿真时长 [s]
+    
+    [[nodiscard]] std::vector<unsigned> thread_counts() const {
+        if(!threads.empty()) return threads;
+        std::vector<unsigned> t;
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for(unsigned n = 1; n < hw; n *= 2) t.push_back(n);
+        t.push_back(hw);
+        return t;
+    }
+    
+    // 逗号分隔的正整数列表
+    template<typename T>
+    static std::vector<T> parse_list(const char* text) {
+        std::vector<T> out;
+        for(const char* p = text; *p;) {
+            char* end = nullptr;
+            long v = std::strtol(p, &end, 10);
+            if(end == p || v <= 0) throw std::runtime_error(std::string("Invalid list: ") + text);
+            out.push_back(T(v));
+            p = *end == ',' ? end + 1 : end;
+            if(*end && *end != ',') throw std::runtime_error(std::string("Invalid list: ") + text);
+        }
+        return out;
+    }
+    
+    static Options parse(int argc, char** argv) {
+        Options opt;
+        for(int i = 1; i < argc; ++i) {
+            auto value = [&]() -> const char* {
+                if(i + 1 >= argc) throw std::runtime_error(std::string("Missing value for ") + argv[i]);
+                return argv[++i];
+            };
+            if(!std::strcmp(argv[i], "--suite")) opt.suite = value();
+            else if(!std::strcmp(argv[i], "--filter")) opt.filter = value();
+            else if(!std::strcmp(argv[i], "--json")) opt.json_path = value();
+            else if(!std::strcmp(argv[i], "--trace")) opt.trace_path = value();
+            else if(!std::strcmp(argv[i], "--hw-counters")) opt.hw_counters = true;
+            else if(!std::strcmp(argv[i], "--metrics")) opt.metrics = true;
+            else if(!std::strcmp(argv[i], "--samples")) opt.samples = std::max(2, std::atoi(value()));
+            else if(!std::strcmp(argv[i], "--min-time-ms")) opt.min_sample_ms = std::atof(value());
+            else if(!std::strcmp(argv[i], "--actors")) opt.actor_counts = parse_list<size_t>(value());
+            else if(!std::strcmp(argv[i], "--threads")) opt.threads = parse_list<unsigned>(value());
+            else if(!std::strcmp(argv[i], "--frame-seconds")) opt.frame_seconds = std::atof(value());
+            else if(!std::strcmp(argv[i], "--max-config-seconds")) opt.max_config_seconds = std::atof(value());
+            else if(!std::strcmp(argv[i], "--validate-seconds")) opt.validate_seconds = std::atof(value());
+            else if(!std::strcmp(argv[i], "--quick")) {
+                opt.samples = 5;
+                opt.min_sample_ms = 2.0;
+                opt.frame_seconds = 0.5;
+                opt.max_config_seconds = 1.0;
+                opt.validate_seconds = 5.0;
+            }
+            else throw std::runtime_error(std::string("Unknown option: ") + argv[i]);
+        }
+        if(opt.suite != "all" && opt.suite != "kernels" && opt.suite != "frames" &&
+           opt.suite != "validate") {
+            throw std::runtime_error("Unknown suite: " + opt.suite);
+        }
+        return opt;
+    }
+    
+    [[nodiscard]] bool runs(const char* name) const { return suite == "all" || suite == name; }
+    
+    [[nodiscard]] bool selected(const std::string& name) const {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+};
+
+// 微基准：fn() 一次处理 items 个元素
+struct KernelResult {
+    std::string name;
+    double items_per_call = 1.0;
+    size_t iterations = 0;          // 每次采样的调用次数
+    Stats ns_per_item;
+    double items_per_second = 0.0;
+};
+
+class KernelRunner {
+    Options opt;
+    std::vector<KernelResult> results;
+    
+    using Clock = std::chrono::steady_clock;
+    
+public:
+    explicit KernelRunner(const Options& o) : opt(o) {}
+    
+    template<typename Fn>
+    void run(const std::string& name, double items_per_call, Fn&& fn) {
+        if(!opt.selected(name)) return;
+        
+        // 1. 预热 + 标定：迭代数加倍直到单次采样达到最短时长
+        size_t iterations = 1;
+        for(;;) {
+            double ms = time_ms(fn, iterations);
+            if(ms >= opt.min_sample_ms || iterations >= (size_t(1) << 30)) break;
+            iterations *= ms > 0.0 ? std::clamp<size_t>(size_t(opt.min_sample_ms / ms * 1.2) + 1, 2, 64) : 64;
+        }
+        
+        // 2. 采样
+        std::vector<double> ns;
+        ns.reserve(opt.samples);
+        for(int s = 0; s < opt.samples; ++s) {
+            ns.push_back(time_ms(fn, iterations) * 1e6 / (iterations * items_per_call));
+        }
+        
+        KernelResult r;
+        r.name = name;
+        r.items_per_call = items_per_call;
+        r.iterations = iterations;
+        r.ns_per_item = Stats::of(ns);
+        r.items_per_second = r.ns_per_item.median > 0.0 ? 1e9 / r.ns_per_item.median : 0.0;
+        std::fprintf(stderr, "%-44s %12.3f ns/item  %14.0f items/s  (cv %.1f%%)\n", name.c_str(),
+                     r.ns_per_item.median, r.items_per_second,
+                     r.ns_per_item.mean > 0.0 ? 100.0 * r.ns_per_item.stddev / r.ns_per_item.mean : 0.0);
+        results.push_back(std::move(r));
+    }
+    
+    [[nodiscard]] const std::vector<KernelResult>& get_results() const { return results; }
+    
+    void write_json(std::ostream& os) const {
+        os << "[";
+        for(size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << (i ? ",\n    " : "\n    ")
+               << "{\"name\": \"" << json_escape(r.name) << "\", \"items_per_call\": " << r.items_per_call
+               << ", \"iterations\": " << r.iterations << ", \"samples\": " << opt.samples
+               << ", \"items_per_second\": " << r.items_per_second << ", \"ns_per_item\": ";
+            write_stats(os, r.ns_per_item);
+            os << "}";
+        }
+        os << (results.empty() ? "]" : "\n  ]");
+    }
+    
+private:
+    template<typename Fn>
+    static double time_ms(Fn& fn, size_t iterations) {
+        auto t0 = Clock::now();
+        for(size_t i = 0; i < iterations; ++i) fn();
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+};
+
+} // namespace aino_bench
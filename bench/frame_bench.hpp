@@ -0,0 +1,248 @@
+// =====================================================
+// bench/frame_bench.hpp - 整帧预算基准（脚本化生理场景）
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <ostream>
+#include <cstdio>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "aino_pro/aino_pro.hpp"
+#include "aino_pro/systems/physiological_actor.hpp"
+#include "aino_pro/systems/batch_runner.hpp"
+#include "bench_harness.hpp"
+
+namespace aino_bench {
+
+// 1. 场景脚本（复用 Scenario：刺激时间线 + 扭矩关键帧）
+inline aino_pro::psychology::Stimulus make_stimulus(const char* category, float intensity,
+                                                    float urgency, uint32_t id) {
+    aino_pro::psychology::Stimulus s;
+    s.set_category(category);
+    s.intensity = intensity;
+    s.urgency = urgency;
+    s.familiarity = 0.2f;
+    s.predictability = 0.3f;
+    s.id = id;
+    return s;
+}
+
+inline std::vector<aino_pro::systems::Scenario> frame_scenarios(double duration, size_t joints) {
+    using aino_pro::systems::Scenario;
+    std::vector<Scenario> out;
+    
+    // 静息：无刺激，轻微姿态维持扭矩
+    Scenario idle;
+    idle.name = "idle";
+    idle.duration = duration;
+    idle.torques.times = {0.0};
+    idle.torques.torques = {std::vector<float>(joints, 0.05f)};
+    out.push_back(idle);
+    
+    // 威胁逼近：强度/紧迫度分段上升，后半程恐惧峰值
+    Scenario threat = idle;
+    threat.name = "threat";
+    const int steps = 10;
+    for(int i = 0; i < steps; ++i) {
+        float k = float(i + 1) / steps;
+        threat.stimuli.push_back({duration * i / steps, duration * (i + 1) / steps,
+                                  make_stimulus("threat", k, 0.3f + 0.7f * k, 1)});
+    }
+    out.push_back(threat);
+    
+    // 持续冲刺：屈伸交替的大扭矩直到力竭
+    Scenario sprint;
+    sprint.name = "sprint";
+    sprint.duration = duration;
+    for(double t = 0.0; t <= duration + 0.25; t += 0.25) {
+        sprint.torques.times.push_back(t);
+        sprint.torques.torques.push_back(std::vector<float>(joints, (int(t * 4.0) % 2) ? 0.9f : -0.9f));
+    }
+    out.push_back(sprint);
+    
+    // 悲伤：持续丧失刺激，低姿态扭矩
+    Scenario grief = idle;
+    grief.name = "grief";
+    grief.stimuli.push_back({0.0, duration, make_stimulus("loss", 0.9f, 0.6f, 2)});
+    out.push_back(grief);
+    
+    return out;
+}
+
+struct FrameResult {
+    std::string scenario;
+    size_t actors = 0;
+    unsigned threads = 0;
+    size_t frames = 0;
+    float budget_ms = 0.0f;                                         // 单角色每帧预算
+    double frame_budget_ms = 0.0;                                   // 整帧预算 = 单角色预算 × 每线程角色数
+    Stats frame_ms;
+    double over_budget = 0.0;                                       // 整帧超预算帧比例
+    std::array<double, aino_pro::systems::STAGE_COUNT> stage_ms{};  // 每帧各阶段CPU时间（全部角色求和）均值
+    std::array<aino_pro::HwSample, aino_pro::systems::STAGE_COUNT> stage_counters{}; // 每帧各阶段计数（全部线程求和）
+    aino_pro::systems::MetricsSnapshot metrics;                     // --metrics
+};
+
+// 阶段计数 → JSON（不可用事件为 null）
+inline void write_counters(std::ostream& os, const aino_pro::HwSample& s) {
+    os << "{";
+    for(size_t e = 0; e < aino_pro::HW_EVENT_COUNT; ++e) {
+        os << (e ? ", " : "") << "\"" << aino_pro::hw_event_name(aino_pro::HwEvent(e)) << "\": ";
+        if(s.has(aino_pro::HwEvent(e))) os << s.value[e]; else os << "null";
+    }
+    os << ", \"ipc\": ";
+    if(s.has(aino_pro::HwEvent::Cycles) && s.has(aino_pro::HwEvent::Instructions)) os << s.ipc(); else os << "null";
+    os << "}";
+}
+
+// 2. 执行：每帧全部角色并行更新，记录整帧墙钟时间与各阶段CPU时间
+class FrameRunner {
+    Options opt;
+    std::vector<FrameResult> results;
+    
+public:
+    explicit FrameRunner(const Options& o) : opt(o) {}
+    
+    void run_all() {
+        const size_t joints = aino_pro::biology::JOINT_COUNT;
+        for(const auto& sc : frame_scenarios(opt.frame_seconds, joints)) {
+            for(size_t actors : opt.actor_counts) {
+                for(unsigned threads : opt.thread_counts()) {
+                    std::string name = "frame." + sc.name + "/actors=" + std::to_string(actors) +
+                                       "/threads=" + std::to_string(threads);
+                    if(opt.selected(name)) run(sc, actors, threads);
+                }
+            }
+        }
+    }
+    
+    [[nodiscard]] const std::vector<FrameResult>& get_results() const { return results; }
+    
+    void write_json(std::ostream& os) const {
+        os << "[";
+        for(size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << (i ? ",\n    " : "\n    ")
+               << "{\"scenario\": \"" << json_escape(r.scenario) << "\", \"actors\": " << r.actors
+               << ", \"threads\": " << r.threads << ", \"frames\": " << r.frames
+               << ", \"budget_ms\": " << r.budget_ms << ", \"frame_budget_ms\": " << r.frame_budget_ms
+               << ", \"over_budget\": " << r.over_budget
+               << ", \"frame_ms\": ";
+            write_stats(os, r.frame_ms);
+            os << ", \"stage_ms\": {";
+            for(size_t s = 0; s < r.stage_ms.size(); ++s) {
+                os << (s ? ", " : "") << "\"" << aino_pro::systems::stage_name(aino_pro::systems::PipelineStage(s))
+                   << "\": " << r.stage_ms[s];
+            }
+            os << "}";
+            if(opt.hw_counters) {
+                os << ", \"hw_counters\": {";
+                for(size_t s = 0; s < r.stage_counters.size(); ++s) {
+                    os << (s ? ", " : "") << "\"" << aino_pro::systems::stage_name(aino_pro::systems::PipelineStage(s)) << "\": ";
+                    write_counters(os, r.stage_counters[s]);
+                }
+                os << "}";
+            }
+            if(opt.metrics) {
+                os << ", \"metrics\": ";
+                r.metrics.write_json(os);
+            }
+            os << "}";
+        }
+        os << (results.empty() ? "]" : "\n  ]");
+    }
+    
+private:
+    void run(const aino_pro::systems::Scenario& sc, size_t actor_count, unsigned threads) {
+        using namespace aino_pro;
+        using Clock = std::chrono::steady_clock;
+        
+        EngineContext ctx(sc.config, ContextOptions{false, threads});
+        ctx.metrics().set_enabled(opt.metrics);
+#ifdef _OPENMP
+        // 线程预算：外层按角色并行；单线程时角色内部循环也只用一个线程
+        omp_set_num_threads((int)threads);
+#endif
+        std::vector<std::unique_ptr<systems::PhysiologicalActor>> actors;
+        actors.reserve(actor_count);
+        for(size_t i = 0; i < actor_count; ++i) {
+            actors.push_back(std::make_unique<systems::PhysiologicalActor>(sc.muscle_count, &ctx));
+            actors.back()->set_stage_timing(true);
+        }
+        
+        systems::PhysioBridge input;
+        const size_t frame_count = (size_t)std::ceil(sc.duration / sc.dt);
+        const float budget = ctx.get_config()->budget.cpu_ms_per_frame;
+        
+        FrameResult r;
+        r.scenario = sc.name;
+        r.actors = actor_count;
+        r.threads = threads;
+        r.budget_ms = budget;
+        // 预算按角色计：整帧计时对照 每线程分摊的角色数 × 单角色预算
+        r.frame_budget_ms = (double)budget * actor_count / std::max<size_t>(std::min<size_t>(threads, actor_count), 1);
+        
+        std::vector<double> frame_ms;
+        frame_ms.reserve(frame_count);
+        auto& hw = aino_pro::HardwareCounters::instance();
+        hw.set_enabled(opt.hw_counters);
+        const auto counters_before = hw.totals();
+        const auto wall_start = Clock::now();
+        const long long n = (long long)actor_count;
+        
+        for(size_t f = 0; f < frame_count; ++f) {
+            sc.input_at(f * (double)sc.dt, input);   // 全部角色共享同一脚本输入
+            ctx.end_frame();
+            ctx.begin_frame();
+            
+            auto t0 = Clock::now();
+            #pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+            for(long long i = 0; i < n; ++i) {
+                actors[i]->update(sc.dt, input);
+            }
+            frame_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - t0).count());
+            
+            for(const auto& a : actors) {
+                const auto& stage = a->get_performance().stage_ms;
+                for(size_t s = 0; s < r.stage_ms.size(); ++s) r.stage_ms[s] += stage[s];
+            }
+            
+            if(std::chrono::duration<double>(Clock::now() - wall_start).count() > opt.max_config_seconds) break;
+        }
+        
+        ctx.end_frame();
+        r.frames = frame_ms.size();
+        if(opt.metrics) r.metrics = ctx.metrics().snapshot(16);
+        for(auto& s : r.stage_ms) s /= std::max<size_t>(r.frames, 1);
+        if(opt.hw_counters) {
+            hw.set_enabled(false);
+            const auto counters_after = hw.totals();
+            for(size_t s = 0; s < r.stage_counters.size(); ++s) {
+                auto& c = r.stage_counters[s];
+                c.available = counters_after[s].available;
+                for(size_t e = 0; e < aino_pro::HW_EVENT_COUNT; ++e) {
+                    c.value[e] = (counters_after[s].value[e] - counters_before[s].value[e]) / std::max<size_t>(r.frames, 1);
+                }
+            }
+        }
+        size_t over = 0;
+        for(double ms : frame_ms) over += ms > r.frame_budget_ms;
+        r.over_budget = r.frames ? double(over) / r.frames : 0.0;
+        r.frame_ms = Stats::of(std::move(frame_ms));
+        
+        std::fprintf(stderr, "%-44s p50 %9.3f  p99 %9.3f  max %9.3f ms  (budget %.1f ms/actor = %.1f ms/frame, %5.1f%% over, %zu frames)\n",
+                     ("frame." + r.scenario + "/actors=" + std::to_string(actor_count) +
+                      "/threads=" + std::to_string(threads)).c_str(),
+                     r.frame_ms.p50, r.frame_ms.p99, r.frame_ms.max, budget, r.frame_budget_ms,
+                     100.0 * r.over_budget, r.frames);
+        results.push_back(std::move(r));
+    }
+};
+
+} // namespace aino_bench
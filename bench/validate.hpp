@@ -0,0 +1,778 @@
+// =====================================================
+// bench/validate.hpp - 参考实现 vs 优化路径 差分验证
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <filesystem>
+#include "aino_pro/biology/muscle_huxley.hpp"
+#include "aino_pro/biology/tendon_viscoelastic.hpp"
+#include "aino_pro/biology/metabolism.hpp"
+#include "aino_pro/biology/multibody.hpp"
+#include "aino_pro/neuroscience/spinal_circuit.hpp"
+#include "aino_pro/psychology/cognitive_appraisal.hpp"
+#include "aino_pro/aino_animation.hpp"
+#include "aino_pro/learning/muscle_surrogate.hpp"
+#include "aino_pro/systems/physiological_actor.hpp"
+#include "bench_harness.hpp"
+
+namespace aino_bench {
+namespace reference {
+
+// 原始标量实现（冻结副本，不随优化修改）
+
+class HuxleyFiber {
+    static constexpr float DX = 1.0f;
+    static constexpr float LAMBDA = 10.0f;
+    static constexpr float F1 = 200.0f, G1 = 10.0f, G2 = 50.0f, K = 2.0e-6f;
+    static constexpr float V_MAX = 2500.0f, A = 25.0f, B = 2.5f;
+    
+    std::vector<float> n;
+    float F_ce = 0.0f;
+    
+public:
+    explicit HuxleyFiber(int grid) : n(grid, 0.0f) {}
+    
+    void step(float activation, float /*length*/, float velocity, float dt) {
+        const int grid = (int)n.size();
+        float v_rel = velocity / V_MAX;
+        float sum_force = 0.0f;
+        for(int i = 0; i < grid; ++i) {
+            float x = (i - grid/2) * DX;
+            float f = F1 * std::exp(-std::abs(x) / LAMBDA) * activation;
+            float g = G1 + G2 * std::max(x / LAMBDA, 0.0f) + v_rel * 10.0f;
+            int i_left = std::max(i - 1, 0);
+            int i_right = std::min(i + 1, grid - 1);
+            float convection = v_rel * (n[i_right] - n[i_left]) / (2.0f * DX);
+            float dn_dt = f * (1.0f - n[i]) - g * n[i] - convection;
+            n[i] += dn_dt * dt;
+            n[i] = std::clamp(n[i], 0.0f, 1.0f);
+            sum_force += n[i] * K * (x * 1e-9f);
+        }
+        F_ce = sum_force;
+        if(velocity > 0.0f) F_ce += A * velocity / (B + velocity);
+    }
+    
+    [[nodiscard]] float get_force() const { return F_ce; }
+    [[nodiscard]] float get_activation() const { return n[n.size()/2]; }
+};
+
+class MotorNeuronPool {
+    static constexpr int N_NEURONS = 100;
+    struct Neuron {
+        float firing_rate = 0.0f;
+        float recruitment_threshold = 0.0f;
+        float fatigue = 0.0f;
+        float after_hyperpolarization = 0.0f;
+    };
+    std::vector<Neuron> neurons;
+    float central_drive = 0.0f, spindle_feedback = 0.0f;
+    float ib_inhibition = 0.0f, renshaw_inhibition = 0.0f;
+    
+public:
+    MotorNeuronPool() : neurons(N_NEURONS) {
+        for(int i = 0; i < N_NEURONS; ++i) {
+            neurons[i].recruitment_threshold = std::pow(i / float(N_NEURONS), 1.5f);
+        }
+    }
+    
+    void step(float dt) {
+        float total_drive = central_drive + spindle_feedback * 0.3f -
+                            ib_inhibition * 0.5f - renshaw_inhibition * 0.2f;
+        total_drive = std::clamp(total_drive, 0.0f, 1.0f);
+        for(auto& nr : neurons) {
+            float drive = total_drive - nr.recruitment_threshold;
+            if(drive > 0.0f && nr.after_hyperpolarization <= 0.0f) {
+                nr.firing_rate = std::clamp(50.0f * drive * (1.0f - nr.fatigue), 0.0f, 200.0f);
+                nr.fatigue += nr.firing_rate * dt * 0.0001f;
+                nr.after_hyperpolarization = 0.2f;
+            } else {
+                nr.firing_rate = 0.0f;
+                nr.fatigue = std::max(nr.fatigue - dt * 0.01f, 0.0f);
+                nr.after_hyperpolarization -= dt;
+            }
+        }
+    }
+    
+    [[nodiscard]] float get_average_firing_rate() const {
+        float sum = 0.0f;
+        for(const auto& nr : neurons) sum += nr.firing_rate;
+        return sum / N_NEURONS;
+    }
+    
+    void set_central_drive(float drive) { central_drive = std::clamp(drive, 0.0f, 1.0f); }
+    void set_spindle_feedback(float feedback) { spindle_feedback = feedback; }
+};
+
+class TendonNonlinear {
+    static constexpr int N_TERMS = 5;
+    struct PronyTerm { float modulus, tau, strain_memory = 0.0f; } terms[N_TERMS] = {
+        {0.5e9f, 0.1f}, {0.3e9f, 1.0f}, {0.2e9f, 10.0f}, {0.1e9f, 100.0f}, {0.05e9f, 1000.0f}
+    };
+    static constexpr float E_LINEAR = 1.2e9f, E_NONLINEAR = 8.0e10f, EPSILON_MAX = 0.08f;
+    static constexpr float VISCOSITY = 1500.0f;
+    
+public:
+    float compute_stress(float strain, float strain_rate, float dt) {
+        float epsilon = std::clamp(strain, 0.0f, EPSILON_MAX);
+        float sigma_elastic = E_LINEAR * epsilon + E_NONLINEAR * epsilon * epsilon;
+        float sigma_viscous = VISCOSITY * strain_rate * (1.0f + epsilon * 5.0f);
+        float sigma_history = 0.0f;
+        for(auto& t : terms) {
+            t.strain_memory = t.strain_memory * std::exp(-dt / t.tau) + strain * dt;
+            sigma_history += t.modulus * t.strain_memory / (t.tau + 1e-6f);
+        }
+        float max_stress = E_NONLINEAR * EPSILON_MAX * EPSILON_MAX;
+        return std::clamp(sigma_elastic + sigma_viscous + sigma_history, 0.0f, max_stress);
+    }
+};
+
+class MetabolicSystem {
+    float ATP = 1.0f, PCr = 1.0f, glycogen = 1.0f, lactate = 0.0f, pyruvate = 0.0f;
+    float time_since_exercise = 0.0f;
+    
+public:
+    void update(float activation, float dt) {
+        time_since_exercise += dt;
+        float J_ATP = 0.05f * activation;
+        float J_PCr_syn = 2.5f * PCr * (1.0f - ATP);
+        float J_PCr_rec = 2.5f * 0.1f * (1.0f - PCr);
+        float inhibition = 1.0f / (1.0f + std::exp((lactate * 0.1f - 0.05f) / 0.01f));
+        float J_gly = 0.03f * glycogen * inhibition;
+        float s = std::clamp(time_since_exercise / 30.0f, 0.0f, 1.0f);
+        float J_ox = 0.02f * s * s * (3.0f - 2.0f * s) * pyruvate;
+        float J_lac_clear = 0.01f * lactate / (1.0f + lactate);
+        ATP = std::clamp(ATP + dt * (-J_ATP + J_PCr_syn), 0.0f, 1.0f);
+        PCr = std::clamp(PCr + dt * (-J_PCr_syn + J_PCr_rec), 0.3f, 1.0f);
+        glycogen = std::clamp(glycogen + dt * (-J_gly + 0.005f), 0.0f, 1.0f);
+        lactate = std::clamp(lactate + dt * (J_gly * 0.5f - J_lac_clear), 0.0f, 1.0f);
+        pyruvate = std::clamp(pyruvate + dt * (J_gly * 0.5f - J_ox * 0.7f - J_ox * 0.7f), 0.0f, 0.2f);
+    }
+    
+    [[nodiscard]] float get_fatigue_factor() const {
+        float deficit = (1.0f - ATP) * 0.4f + (1.0f - PCr) * 0.4f;
+        float acidosis = lactate > 0.4f ? (lactate - 0.4f) * 1.5f : 0.0f;
+        return std::clamp(deficit + acidosis, 0.0f, 1.0f);
+    }
+};
+
+// 广播评估：逐事件全角色遍历（网格剔除前的 O(角色 × 事件) 版本）
+inline void appraise_broadcast(const aino_pro::psychology::BroadcastStimulus* events, size_t event_count,
+                               aino_pro::psychology::CrowdAppraisal& crowd) {
+    for(size_t e = 0; e < event_count; ++e) {
+        const auto& ev = events[e];
+        const float inv_r2 = ev.radius > 0.0f ? 1.0f / (ev.radius * ev.radius) : 0.0f;
+        for(size_t i = 0; i < crowd.size(); ++i) {
+            float dx = crowd.x[i] - ev.position.x, dy = crowd.y[i] - ev.position.y, dz = crowd.z[i] - ev.position.z;
+            float q = std::max(1.0f - (dx * dx + dy * dy + dz * dz) * inv_r2, 0.0f);
+            float w = q * q;
+            float relevant = (w * w * ev.relevance > 0.2f) ? w : 0.0f;
+            float I = ev.intensity * w;
+            float threat = ev.threat * relevant, reward = ev.reward * relevant;
+            const float F = crowd.familiarity[i], ST = crowd.stress[i];
+            crowd.fear[i] = std::max(crowd.fear[i], threat * ev.intensity * (2.0f - F) * (1.0f + ST * 0.5f));
+            crowd.anger[i] = std::max(crowd.anger[i], threat * ev.anger);
+            crowd.surprise[i] = std::max(crowd.surprise[i], threat * ev.surprise);
+            crowd.joy[i] = std::max(crowd.joy[i], reward * ev.intensity);
+            crowd.trust[i] = std::max(crowd.trust[i], reward * ev.intensity * F);
+            crowd.sadness[i] = std::max(crowd.sadness[i], ev.loss * relevant * ev.intensity);
+            float coping = crowd.self_efficacy[i] * (1.0f - ST * 0.5f) * (ev.controllability + F * 0.4f);
+            float helpless = (coping < 0.3f && I > 0.6f && relevant > 0.0f) ? I : 0.0f;
+            crowd.anxiety[i] = std::max(crowd.anxiety[i], helpless * (1.0f - coping));
+            crowd.shame[i] = std::max(crowd.shame[i], helpless * (1.0f - crowd.self_esteem[i]));
+        }
+    }
+}
+
+} // namespace reference
+
+// 动画图验证节点：写出与参数成正比的姿态，统计 on_evaluate 调用次数
+//   覆盖：叶节点整体写入，有子节点时在子节点输出上叠加（幂等）；叠加：在输入姿态上累加（非幂等）
+class CountingPoseNode : public aino_animation::AnimationNodeBase {
+    const char* parameter;
+    bool static_node;
+    bool additive;
+    
+public:
+    size_t evaluations = 0;
+    
+    CountingPoseNode(const char* param, bool is_static_node, bool is_additive = false)
+        : parameter(param), static_node(is_static_node), additive(is_additive) {}
+    
+    [[nodiscard]] bool is_static() const override { return static_node; }
+    [[nodiscard]] bool is_idempotent() const override { return !additive; }
+    
+protected:
+    void on_evaluate(aino_animation::AnimationContext& ctx) override {
+        ++evaluations;
+        for(const auto& child : children) child->evaluate(ctx);
+        const float value = ctx.parameters[parameter];
+        auto& pose = *ctx.output;
+        const bool reads_input = additive || !children.empty();
+        for(size_t i = 0; i < pose.bone_count; ++i) {
+            pose.rotation_z[i] = (reads_input ? pose.rotation_z[i] : 0.0f) + value * float(i + 1) * 0.01f;
+        }
+    }
+};
+
+// 偏差累计（按参考值峰值归一化）
+struct Divergence {
+    double max_abs = 0.0, sum_sq = 0.0, ref_peak = 0.0;
+    size_t count = 0;
+    
+    void add(double ref, double opt) {
+        double d = std::abs(opt - ref);
+        if(!(d <= max_abs)) max_abs = d; // NaN 也记为最大偏差
+        sum_sq += d * d;
+        ref_peak = std::max(ref_peak, std::abs(ref));
+        ++count;
+    }
+    
+    [[nodiscard]] double rms() const { return count ? std::sqrt(sum_sq / count) : 0.0; }
+    [[nodiscard]] double scale() const { return ref_peak > 0.0 ? ref_peak : 1.0; }
+    [[nodiscard]] double max_rel() const { return max_abs / scale(); }
+    [[nodiscard]] double rms_rel() const { return rms() / scale(); }
+};
+
+struct ValidationResult {
+    std::string name;           // 优化路径
+    std::string reference;      // 对照实现
+    std::string input;          // random / scripted
+    std::string quantity;       // force / activation / joint_angle ...
+    size_t steps = 0;
+    Divergence divergence;
+    double tolerance = -1.0;    // 归一化最大偏差上限（< 0 = 仅报告）
+    
+    [[nodiscard]] bool passed() const {
+        return tolerance < 0.0 || divergence.max_rel() <= tolerance;
+    }
+};
+
+// 输入信号：random = 平滑随机游走（固定种子），scripted = 阶跃 / 斜坡 / 静息
+class InputSignal {
+    bool random;
+    std::mt19937 rng;
+    float value = 0.0f;
+    
+public:
+    InputSignal(bool is_random, uint32_t seed) : random(is_random), rng(seed) {}
+    
+    float at(double t) {
+        if(random) {
+            std::normal_distribution<float> noise(0.0f, 0.05f);
+            value = std::clamp(value * 0.98f + 0.02f * 0.5f + noise(rng), 0.0f, 1.0f);
+            return value;
+        }
+        double phase = std::fmod(t, 8.0);
+        if(phase < 2.0) return 1.0f;                        // 最大收缩
+        if(phase < 4.0) return 0.0f;                        // 放松
+        if(phase < 6.0) return float((phase - 4.0) / 2.0);  // 斜坡
+        return 0.3f;                                        // 维持
+    }
+};
+
+class Validator {
+    Options opt;
+    std::vector<ValidationResult> results;
+    std::shared_ptr<const aino_pro::learning::SurrogateMLP> surrogate;   // 首次验证时训练，两种输入共用
+    
+public:
+    explicit Validator(const Options& o) : opt(o) {}
+    
+    void run_all() {
+        for(bool random : {true, false}) {
+            validate_huxley(random);
+            validate_motor_neurons(random);
+            validate_tendon(random);
+            validate_metabolism(random);
+            validate_muscle_models(random);
+            validate_joint_angles(random);
+            validate_broadcast_appraisal(random);
+            validate_animation_cache(random);
+            validate_simd_dot(random);
+            validate_surrogate(random);
+        }
+    }
+    
+    [[nodiscard]] const std::vector<ValidationResult>& get_results() const { return results; }
+    
+    [[nodiscard]] size_t failures() const {
+        return (size_t)std::count_if(results.begin(), results.end(),
+                                     [](const ValidationResult& r) { return !r.passed(); });
+    }
+    
+    void write_json(std::ostream& os) const {
+        os << "[";
+        for(size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            const auto& d = r.divergence;
+            os << (i ? ",\n    " : "\n    ")
+               << "{\"name\": \"" << json_escape(r.name) << "\", \"reference\": \"" << json_escape(r.reference)
+               << "\", \"input\": \"" << r.input << "\", \"quantity\": \"" << r.quantity
+               << "\", \"steps\": " << r.steps << ", \"max_abs\": " << d.max_abs << ", \"rms\": " << d.rms()
+               << ", \"reference_peak\": " << d.ref_peak << ", \"max_rel\": " << d.max_rel()
+               << ", \"rms_rel\": " << d.rms_rel() << ", \"tolerance\": ";
+            if(r.tolerance < 0.0) os << "null"; else os << r.tolerance;
+            os << ", \"passed\": " << (r.passed() ? "true" : "false") << "}";
+        }
+        os << (results.empty() ? "]" : "\n  ]");
+    }
+    
+private:
+    static constexpr float DT = 0.001f;
+    
+    [[nodiscard]] size_t steps(float dt = DT) const { return (size_t)std::ceil(opt.validate_seconds / dt); }
+    
+    // 单项对照：每步调用 step(t) 返回 {参考值, 优化值}
+    void check(const std::string& name, const std::string& reference, bool random,
+               const std::string& quantity, double tolerance, size_t count,
+               const std::function<std::pair<double, double>(size_t)>& step) {
+        ValidationResult r;
+        r.name = name;
+        r.reference = reference;
+        r.input = random ? "random" : "scripted";
+        r.quantity = quantity;
+        r.tolerance = tolerance;
+        if(!opt.selected("validate." + name)) return;
+        
+        for(size_t i = 0; i < count; ++i) {
+            auto [ref, val] = step(i);
+            r.divergence.add(ref, val);
+        }
+        r.steps = count;
+        
+        std::fprintf(stderr, "%-4s %-40s %-8s %-12s max_rel %10.3e  rms_rel %10.3e%s\n",
+                     r.passed() ? "ok" : "FAIL", name.c_str(), r.input.c_str(), quantity.c_str(),
+                     r.divergence.max_rel(), r.divergence.rms_rel(), tolerance < 0.0 ? "  (report only)" : "");
+        results.push_back(std::move(r));
+    }
+    
+    // 1. 特化/展开网格内核 vs 原始标量循环
+    void validate_huxley(bool random) {
+        std::vector<int> grids(aino_pro::biology::HuxleyFiber::SPECIALIZED_GRID_SIZES.begin(),
+                               aino_pro::biology::HuxleyFiber::SPECIALIZED_GRID_SIZES.end());
+        grids.push_back(1000);
+        for(int grid : grids) {
+            reference::HuxleyFiber ref(grid);
+            aino_pro::biology::HuxleyFiber fiber(grid);
+            InputSignal activation(random, 1), velocity(random, 2);
+            check("huxley_fiber.step/grid=" + std::to_string(grid), "scalar", random, "force", 1e-5,
+                  steps(), [&](size_t i) {
+                double t = i * DT;
+                float a = activation.at(t);
+                float v = (velocity.at(t + 1.0) - 0.5f) * 400.0f;
+                ref.step(a, 1.0f, v, DT);
+                fiber.step(a, 1.0f, v, DT);
+                return std::make_pair((double)ref.get_force(), (double)fiber.get_force());
+            });
+        }
+    }
+    
+    void validate_motor_neurons(bool random) {
+        reference::MotorNeuronPool ref;
+        aino_pro::neuroscience::MotorNeuronPool pool;
+        InputSignal drive(random, 3);
+        check("motor_neuron_pool.step", "scalar", random, "firing_rate", 1e-5, steps(), [&](size_t i) {
+            float d = drive.at(i * DT);
+            ref.set_central_drive(d);
+            pool.set_central_drive(d);
+            ref.step(DT);
+            pool.step(DT);
+            return std::make_pair((double)ref.get_average_firing_rate(), (double)pool.get_average_firing_rate());
+        });
+    }
+    
+    void validate_tendon(bool random) {
+        reference::TendonNonlinear ref, ref_linear;
+        aino_pro::biology::TendonNonlinear tendon, linear;
+        linear.set_linear_mode();
+        InputSignal strain(random, 4);
+        float last = 0.0f;
+        check("tendon_nonlinear.compute_stress", "scalar", random, "stress", 1e-5, steps(), [&](size_t i) {
+            float e = 0.08f * strain.at(i * DT);
+            float rate = (e - last) / DT;
+            last = e;
+            return std::make_pair((double)ref.compute_stress(e, rate, DT),
+                                  (double)tendon.compute_stress(e, rate, DT));
+        });
+        
+        // Realtime 线性模式：简化模型，仅报告偏差
+        last = 0.0f;
+        InputSignal strain2(random, 4);
+        check("tendon_nonlinear.linear_mode", "scalar", random, "stress", -1.0, steps(), [&](size_t i) {
+            float e = 0.08f * strain2.at(i * DT);
+            float rate = (e - last) / DT;
+            last = e;
+            return std::make_pair((double)ref_linear.compute_stress(e, rate, DT),
+                                  (double)linear.compute_stress(e, rate, DT));
+        });
+    }
+    
+    // 2. 代谢：逐帧 vs 标量参考；流水线的4帧降频 vs 逐帧
+    void validate_metabolism(bool random) {
+        const float frame_dt = 1.0f / 60.0f;
+        const size_t frames = steps(frame_dt);
+        {
+            reference::MetabolicSystem ref;
+            aino_pro::biology::MetabolicSystem met;
+            InputSignal activation(random, 5);
+            check("metabolic_system.update", "scalar", random, "fatigue", 1e-5, frames, [&](size_t i) {
+                float a = activation.at(i * frame_dt);
+                ref.update(a, frame_dt);
+                met.update(a, frame_dt);
+                return std::make_pair((double)ref.get_fatigue_factor(), (double)met.get_fatigue_factor());
+            });
+        }
+        {
+            aino_pro::biology::MetabolicSystem every_frame, decimated;
+            InputSignal activation(random, 5);
+            check("metabolic_system.decimated/every=4", "metabolic_system.update", random, "fatigue", 0.05,
+                  frames, [&](size_t i) {
+                float a = activation.at(i * frame_dt);
+                every_frame.update(a, frame_dt);
+                if((i + 1) % 4 == 0) decimated.update(a, frame_dt * 4.0f);
+                return std::make_pair((double)every_frame.get_fatigue_factor(), (double)decimated.get_fatigue_factor());
+            });
+        }
+    }
+    
+    // 3. 肌肉：分箱估计 / 估计+延迟精算 vs 每帧Huxley（均从零状态出发，无需预先精算）
+    void validate_muscle_models(bool random) {
+        using aino_pro::biology::Muscle;
+        const float frame_dt = 1.0f / 60.0f;
+        const size_t frames = steps(frame_dt);
+        const int fibers = 8;
+        {
+            Muscle full(fibers), moment(fibers);
+            InputSignal activation(random, 6);
+            check("muscle.estimate", "muscle.step", random, "force", 0.1, frames, [&](size_t i) {
+                float a = activation.at(i * frame_dt);
+                full.step(a, frame_dt);
+                moment.estimate(a, frame_dt);
+                return std::make_pair((double)full.get_force(), (double)moment.get_force());
+            });
+        }
+        // every=4 在追赶窗口内（精算逐步重放，精算帧与参考一致）；every=12 超出窗口（从窗口起点的估计状态重放）
+        for(size_t every : {4, 12}) {
+            Muscle full(fibers), deferred(fibers);
+            InputSignal activation(random, 6);
+            check("muscle.estimate_refine/every=" + std::to_string(every), "muscle.step", random, "force",
+                  every <= 4 ? 0.05 : 0.1, frames, [&](size_t i) {
+                float a = activation.at(i * frame_dt);
+                full.step(a, frame_dt);
+                deferred.estimate(a, frame_dt);
+                if((i + 1) % every == 0) deferred.refine();
+                return std::make_pair((double)full.get_force(), (double)deferred.get_force());
+            });
+        }
+        // 可中断阶段：每帧全部估计，截止前只精算一部分（按轮转模拟优先级），其余保留估计值
+        {
+            const size_t count = 8, refined_per_frame = 2;
+            std::vector<Muscle> full(count, Muscle(fibers)), anytime = full;
+            std::vector<InputSignal> activations;
+            for(size_t m = 0; m < count; ++m) activations.emplace_back(random, uint32_t(30 + m));
+            std::vector<double> ref_force(count), force(count);
+            check("muscle.anytime/refine=2of8", "muscle.step", random, "force", 0.1, frames * count,
+                  [&](size_t k) {
+                const size_t frame = k / count, m = k % count;
+                if(m == 0) {
+                    for(size_t j = 0; j < count; ++j) {
+                        float a = activations[j].at(frame * frame_dt);
+                        full[j].step(a, frame_dt);
+                        anytime[j].estimate(a, frame_dt);
+                    }
+                    for(size_t r = 0; r < refined_per_frame; ++r) {
+                        anytime[(frame * refined_per_frame + r) % count].refine();
+                    }
+                    for(size_t j = 0; j < count; ++j) {
+                        ref_force[j] = full[j].get_force();
+                        force[j] = anytime[j].get_force();
+                    }
+                }
+                return std::make_pair(ref_force[m], force[m]);
+            });
+        }
+    }
+    
+    // 4. 关节角：真实角色（期望扭矩 → 拮抗对肌肉 → 关节扭矩 → 骨骼）vs 手工接线的逐帧Huxley参考
+    //    （屈/伸肌力按满激活稳态归一化后作差；长时程累积偏差）
+    void validate_joint_angles(bool random) {
+        using aino_pro::biology::Muscle;
+        const float frame_dt = 1.0f / 60.0f;
+        const size_t frames = steps(frame_dt);
+        const size_t joints = 4;
+        const float max_torque = 20.0f;
+        
+        aino_pro::EngineContext ctx(driven_config(), aino_pro::ContextOptions{false, 0});
+        auto actor = driven_actor(ctx, joints);
+        aino_pro::systems::PhysioBridge input;
+        input.desired_joint_torques.assign(joints, 0.0f);
+        
+        aino_pro::biology::ArticulatedSkeleton ref_skeleton;
+        std::vector<Muscle> ref_muscles(joints * 2, Muscle(4));
+        for(auto& m : ref_muscles) m.set_grid_size(DRIVEN_GRID);
+        std::vector<InputSignal> drives;
+        for(size_t j = 0; j < joints; ++j) drives.emplace_back(random, uint32_t(10 + j));
+        std::vector<aino_math::Vec3> ref_angles;
+        
+        check("physiological_actor.joint_angles", "skeleton.huxley_driven", random, "joint_angle", 1e-4,
+              frames * joints, [&](size_t k) {
+            const size_t frame = k / joints;
+            if(k % joints == 0) {
+                for(size_t j = 0; j < joints; ++j) {
+                    float d = drives[j].at(frame * frame_dt) * 2.0f - 1.0f;
+                    input.desired_joint_torques[j] = d;
+                    auto& flexor = ref_muscles[2 * j];
+                    auto& extensor = ref_muscles[2 * j + 1];
+                    flexor.step(std::max(d, 0.0f), frame_dt);
+                    extensor.step(std::max(-d, 0.0f), frame_dt);
+                    float tau = max_torque * (flexor.get_force() / flexor.get_max_force() -
+                                              extensor.get_force() / extensor.get_max_force());
+                    ref_skeleton.set_muscle_torque(j, {0.0f, 0.0f, tau});
+                }
+                ref_skeleton.forward_dynamics(frame_dt);
+                ref_angles = ref_skeleton.get_joint_angles();
+                actor->update(frame_dt, input);
+            }
+            const size_t j = k % joints;
+            return std::make_pair((double)ref_angles[j].z, (double)actor->get_joint_angles()[j].z);
+        });
+    }
+    
+    // 5. 广播评估：网格剔除 vs 全量遍历（random = 随机散布，scripted = 规则方阵 + 全局事件）
+    void validate_broadcast_appraisal(bool random) {
+        using namespace aino_pro::psychology;
+        const size_t actors = 2000, event_count = 64;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        
+        CrowdAppraisal ref, crowd;
+        ref.resize(actors);
+        for(size_t i = 0; i < actors; ++i) {
+            aino_math::Vec3 p = random ? aino_math::Vec3{u(rng) * 200.0f - 100.0f, u(rng) * 2.0f, u(rng) * 200.0f - 100.0f}
+                                       : aino_math::Vec3{(i % 50) * 2.0f - 50.0f, 0.0f, (i / 50) * 2.0f - 40.0f};
+            ref.set_actor(i, p, AppraisalTraits{u(rng), u(rng), u(rng) * 0.5f}, u(rng));
+        }
+        crowd = ref;
+        
+        static const char* CATEGORIES[] = {"threat", "reward", "loss", "noise"};
+        std::vector<BroadcastStimulus> events;
+        for(size_t e = 0; e < event_count; ++e) {
+            Stimulus s;
+            s.set_category(CATEGORIES[e % 4]);
+            s.position = {u(rng) * 200.0f - 100.0f, u(rng) * 2.0f, u(rng) * 200.0f - 100.0f};
+            s.intensity = u(rng);
+            s.urgency = u(rng);
+            s.predictability = u(rng);
+            float radius = (!random && e % 16 == 0) ? 0.0f : 2.0f + u(rng) * 18.0f;
+            events.push_back(BroadcastStimulus::prepare(s, radius));
+        }
+        
+        reference::appraise_broadcast(events.data(), events.size(), ref);
+        CognitiveAppraiser().appraise_broadcast(events.data(), events.size(), crowd);
+        
+        const std::vector<float> CrowdAppraisal::* outputs[] = {
+            &CrowdAppraisal::fear, &CrowdAppraisal::anger, &CrowdAppraisal::surprise, &CrowdAppraisal::joy,
+            &CrowdAppraisal::trust, &CrowdAppraisal::sadness, &CrowdAppraisal::anxiety, &CrowdAppraisal::shame};
+        check("cognitive_appraiser.appraise_broadcast", "full_scan", random, "emotion", 1e-6,
+              actors * 8, [&](size_t k) {
+            const auto col = outputs[k % 8];
+            return std::make_pair((double)(ref.*col)[k / 8], (double)(crowd.*col)[k / 8]);
+        });
+    }
+    
+    // 6. 动画图脏标记：持久姿态缓冲上多帧求值，静态图 vs 动态图（姿态一致）；
+    //    静态根节点仅在首帧与参数变化帧重算（random = 随机帧改参数，scripted = 固定周期）
+    void validate_animation_cache(bool random) {
+        const size_t frames = 240, bones = 23;
+        std::mt19937 rng(8);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        
+        struct Graph {
+            std::shared_ptr<CountingPoseNode> root, leaf;
+            aino_animation::AnimationContext ctx;
+            aino_animation::PoseBuffer pose{23};
+            
+            explicit Graph(bool is_static) :
+                root(std::make_shared<CountingPoseNode>("bias", is_static)),
+                leaf(std::make_shared<CountingPoseNode>("gain", is_static)) {
+                root->add_child(leaf);
+                ctx.output = &pose;
+            }
+        } ref(false), cached(true);
+        
+        std::vector<float> ref_pose, pose;
+        std::vector<double> expected, actual;
+        for(size_t f = 0; f < frames; ++f) {
+            bool change = random ? u(rng) < 0.1f : f % 45 == 0 || f % 60 == 0;
+            float gain = u(rng), bias = u(rng);
+            const uint64_t before = cached.ctx.parameter_version;
+            for(Graph* g : {&ref, &cached}) {
+                if(change) {
+                    g->ctx.set_parameter("gain", gain);
+                    g->ctx.set_parameter("bias", bias);
+                }
+            }
+            const size_t evaluations = cached.root->evaluations;
+            ref.root->evaluate(ref.ctx);
+            cached.root->evaluate(cached.ctx);
+            ref_pose.insert(ref_pose.end(), ref.pose.rotation_z.begin(), ref.pose.rotation_z.end());
+            pose.insert(pose.end(), cached.pose.rotation_z.begin(), cached.pose.rotation_z.end());
+            expected.push_back(f == 0 || cached.ctx.parameter_version != before ? 1.0 : 0.0);
+            actual.push_back(double(cached.root->evaluations - evaluations));
+        }
+        
+        check("animation_graph.cached/persistent_buffer", "dynamic_graph", random, "rotation_z", 0.0,
+              frames * bones, [&](size_t k) { return std::make_pair((double)ref_pose[k], (double)pose[k]); });
+        check("animation_graph.reuse/persistent_buffer", "parameter_changes", random, "evaluations", 0.0,
+              frames, [&](size_t f) { return std::make_pair(expected[f], actual[f]); });
+        
+        // 静态但非幂等的叠加节点：持久缓冲上每帧都须重算（与动态叠加节点逐帧累加一致）
+        auto dynamic_add = std::make_shared<CountingPoseNode>("bias", false, true);
+        auto static_add = std::make_shared<CountingPoseNode>("bias", true, true);
+        aino_animation::AnimationContext ref_ctx, ctx;
+        aino_animation::PoseBuffer ref_buffer(bones), buffer(bones);
+        ref_ctx.output = &ref_buffer;
+        ctx.output = &buffer;
+        ref_pose.clear();
+        pose.clear();
+        for(size_t f = 0; f < frames; ++f) {
+            if(random ? u(rng) < 0.1f : f % 45 == 0) {
+                float bias = u(rng);
+                ref_ctx.set_parameter("bias", bias);
+                ctx.set_parameter("bias", bias);
+            }
+            dynamic_add->evaluate(ref_ctx);
+            static_add->evaluate(ctx);
+            ref_pose.insert(ref_pose.end(), ref_buffer.rotation_z.begin(), ref_buffer.rotation_z.end());
+            pose.insert(pose.end(), buffer.rotation_z.begin(), buffer.rotation_z.end());
+        }
+        check("animation_graph.additive/persistent_buffer", "dynamic_graph", random, "rotation_z", 0.0,
+              frames * bones, [&](size_t k) { return std::make_pair((double)ref_pose[k], (double)pose[k]); });
+    }
+    
+    // 7. 代理模型点积内核（AVX-512 / AVX2+FMA / 标量，按编译目标）vs 双精度标量累加
+    void validate_simd_dot(bool random) {
+        namespace ld = aino_pro::learning::detail;
+        std::mt19937 rng(random ? 9 : 10);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        std::vector<float> a, b;
+        const size_t lengths[] = {16, 32, 64, 112, 256};
+        check("surrogate.detail::dot", "scalar_double", random, "dot", 1e-5, 1000, [&](size_t k) {
+            const size_t n = lengths[k % 5];
+            a.resize(n);
+            b.resize(n);
+            for(size_t i = 0; i < n; ++i) {
+                a[i] = random ? normal(rng) : std::sin(0.1f * float(i + k));
+                b[i] = random ? normal(rng) : std::cos(0.07f * float(i * k % 97));
+            }
+            double ref = 0.0;
+            for(size_t i = 0; i < n; ++i) ref += (double)a[i] * b[i];
+            return std::make_pair(ref, (double)ld::dot(a.data(), b.data(), n));
+        });
+    }
+    
+    // 驱动验证用角色：关闭情绪 / 神经 / 肌腱 / 代谢，期望扭矩直接作为节段净驱动；预算不设限，每帧全部精算
+    static constexpr int DRIVEN_GRID = 10;
+    
+    static aino_pro::Config driven_config() {
+        aino_pro::Config cfg;
+        cfg.budget.cpu_ms_per_frame = 1.0e9f;
+        return cfg;
+    }
+    
+    static std::unique_ptr<aino_pro::systems::PhysiologicalActor> driven_actor(aino_pro::EngineContext& ctx, size_t joints) {
+        auto actor = std::make_unique<aino_pro::systems::PhysiologicalActor>(joints * 2, &ctx);
+        aino_pro::systems::LodLevel level;
+        level.grid_size = DRIVEN_GRID;
+        level.run_emotion = false;
+        level.run_neural = false;
+        level.run_tendons = false;
+        level.run_metabolism = false;
+        actor->apply_lod(0, level);
+        return actor;
+    }
+    
+    // 参考运行：真实角色（每帧Huxley精算）驱动骨骼，记录器采集 (期望扭矩, 节段驱动, 关节角) 作为代理训练样本
+    std::vector<aino_pro::systems::TrainingSample> reference_run(bool random, uint32_t seed, size_t joints, size_t frames) const {
+        const float frame_dt = 1.0f / 60.0f;
+        aino_pro::EngineContext ctx(driven_config(), aino_pro::ContextOptions{true, 0});
+        ctx.get_recorder()->enable_capture(true);
+        auto actor = driven_actor(ctx, joints);
+        aino_pro::systems::PhysioBridge input;
+        input.desired_joint_torques.assign(joints, 0.0f);
+        std::vector<InputSignal> drives;
+        for(size_t j = 0; j < joints; ++j) drives.emplace_back(random, uint32_t(seed + j));
+        
+        for(size_t f = 0; f < frames; ++f) {
+            for(size_t j = 0; j < joints; ++j) input.desired_joint_torques[j] = drives[j].at(f * frame_dt) * 2.0f - 1.0f;
+            actor->update(frame_dt, input);
+        }
+        return ctx.get_recorder()->get_captured();
+    }
+    
+    // 8. 代理模型：以随机输入参考运行训练（SurrogateTrainer），在另一段输入上逐帧单步预测
+    //    （上一帧状态取参考值，不自回归）vs 参考运行
+    void validate_surrogate(bool random) {
+        using namespace aino_pro::learning;
+        const size_t joints = 4;
+        const SurrogateLayout layout{joints, joints};   // 前 joints 个关节 / 节段（其余关节无驱动）
+        if(!opt.selected("validate.surrogate_mlp.forward/activation") &&
+           !opt.selected("validate.surrogate_mlp.forward/joint_angle")) return;   // 训练较慢，未选中时跳过
+        if(!surrogate) {
+            SurrogateMLP model(layout, 32, 2);
+            TrainOptions train;
+            train.epochs = 150;
+            train.batch_size = 32;
+            train.learning_rate = 1e-2f;
+            // 随机游走 + 脚本（阶跃/斜坡）两段会话，覆盖满幅输入；训练集固定 20 s，不随 --validate-seconds 缩短
+            const size_t train_frames = 1200;
+            auto samples = reference_run(true, 40, joints, train_frames);
+            const auto scripted = reference_run(false, 40, joints, train_frames);
+            samples.insert(samples.end(), scripted.begin(), scripted.end());
+            SurrogateTrainer::train(model, samples, train);
+            
+            // 经 save / load 往返后验证（覆盖权重文件格式）
+            const std::string path = (std::filesystem::temp_directory_path() / "aino_bench_surrogate.bin").string();
+            model.save(path);
+            surrogate = std::make_shared<SurrogateMLP>(SurrogateMLP::load(path));
+            std::filesystem::remove(path);
+        }
+        
+        const auto run = reference_run(random, 50, joints, steps(1.0f / 60.0f));
+        std::vector<float> inputs, targets, out(layout.output_size());
+        SurrogateTrainer::build_dataset(run, layout, inputs, targets);
+        const size_t count = inputs.size() / layout.input_size();
+        std::vector<float> predicted(targets.size());
+        SurrogateMLP::Workspace ws;
+        for(size_t s = 0; s < count; ++s) {
+            surrogate->forward(&inputs[s * layout.input_size()], out.data(), ws);
+            for(size_t o = 0; o < out.size(); ++o) {
+                // 与 PhysiologicalActor::run_surrogate 一致：节段净驱动截断到 [-1, 1]
+                predicted[s * out.size() + o] = o < layout.activation_count ? std::clamp(out[o], -1.0f, 1.0f) : out[o];
+            }
+        }
+        
+        const size_t no = layout.output_size();
+        for(bool angles : {false, true}) {
+            const size_t first = angles ? layout.activation_count : 0;
+            const size_t width = angles ? layout.joint_count : layout.activation_count;
+            check(std::string("surrogate_mlp.forward/") + (angles ? "joint_angle" : "activation"),
+                  "reference_run", random, angles ? "joint_angle" : "activation", 0.25,
+                  count * width, [&](size_t k) {
+                const size_t idx = (k / width) * no + first + k % width;
+                return std::make_pair((double)targets[idx], (double)predicted[idx]);
+            });
+        }
+    }
+};
+
+} // namespace aino_bench
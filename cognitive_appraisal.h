@@ -3,14 +3,42 @@
 // =====================================================
 
 #pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
 #include "emotion_model.hpp"
 #include "../aino_animation.hpp"
 #include "../aino_math.hpp"
+#include "../profiler.hpp"
 
 namespace aino_pro {
 namespace psychology {
 
+// 刺激类别（产生刺激时由字符串驻留为ID，评估内核只比较整数）
+enum class StimulusCategory : uint8_t {
+    Neutral = 0,
+    Threat,     // "threat" / "enemy"
+    Reward,     // "reward" / "friend"
+    Loss,       // "loss"
+    Unresolved = 0xFF   // 仅直接写了 category 字符串、未经 set_category
+};
+
+[[nodiscard]] inline StimulusCategory intern_category(std::string_view name) {
+    if(name == "threat" || name == "enemy") return StimulusCategory::Threat;
+    if(name == "reward" || name == "friend") return StimulusCategory::Reward;
+    if(name == "loss") return StimulusCategory::Loss;
+    return StimulusCategory::Neutral;
+}
+
 // 刺激事件结构
+//   类别在产生处经 set_category 驻留一次，之后各帧各角色只读 kind；
+//   直接改 category 字符串时需重新 set_category（否则每次使用都回退到字符串比较）
 struct Stimulus {
     std::string category;
     float intensity = 0.0f;
@@ -18,6 +46,232 @@ struct Stimulus {
     float urgency = 0.0f;
     float familiarity = 0.5f;
     float predictability = 0.5f;
+    uint32_t id = 0;                // 世界内唯一ID（0 = 匿名，不进入空间索引）
+    StimulusCategory kind = StimulusCategory::Unresolved;
+    
+    void set_category(std::string_view name) {
+        category = name;
+        kind = intern_category(name);
+    }
+    
+    [[nodiscard]] StimulusCategory resolved_category() const {
+        return kind != StimulusCategory::Unresolved ? kind : intern_category(category);
+    }
+};
+
+// 刺激批（SoA，每帧复用容量）
+struct StimulusBatch {
+    std::vector<uint32_t> id;
+    std::vector<StimulusCategory> category;
+    std::vector<float> intensity;
+    std::vector<float> urgency;
+    std::vector<float> familiarity;
+    std::vector<float> predictability;
+    std::vector<float> pos_x, pos_y, pos_z;
+    
+    [[nodiscard]] size_t size() const { return intensity.size(); }
+    [[nodiscard]] bool empty() const { return intensity.empty(); }
+    
+    void clear() {
+        id.clear();
+        category.clear();
+        intensity.clear();
+        urgency.clear();
+        familiarity.clear();
+        predictability.clear();
+        pos_x.clear(); pos_y.clear(); pos_z.clear();
+    }
+    
+    void push(StimulusCategory cat, float inten, const aino_math::Vec3& pos, float urg,
+              float fam = 0.5f, float pred = 0.5f, uint32_t stim_id = 0) {
+        id.push_back(stim_id);
+        category.push_back(cat);
+        intensity.push_back(inten);
+        urgency.push_back(urg);
+        familiarity.push_back(fam);
+        predictability.push_back(pred);
+        pos_x.push_back(pos.x); pos_y.push_back(pos.y); pos_z.push_back(pos.z);
+    }
+    
+    void push(const Stimulus& s) {
+        push(s.resolved_category(), s.intensity, s.position, s.urgency,
+             s.familiarity, s.predictability, s.id);
+    }
+    
+    void assign(const std::vector<Stimulus>& stimuli) {
+        assign(stimuli.data(), stimuli.size());
+    }
+    
+    void assign(const Stimulus* stimuli, size_t count) {
+        clear();
+        for(size_t i = 0; i < count; ++i) push(stimuli[i]);
+    }
+};
+
+// 评估所需的角色特质（替代逐刺激构造的 AnimationContext）
+struct AppraisalTraits {
+    float self_efficacy = 0.5f;
+    float self_esteem = 0.5f;
+    float stress = 0.0f;        // 当前心境应激
+};
+
+// 单刺激评估结果（评估涉及的8个情绪分量）
+struct AppraisalTerms {
+    float fear = 0.0f, anger = 0.0f, surprise = 0.0f, joy = 0.0f;
+    float trust = 0.0f, sadness = 0.0f, anxiety = 0.0f, shame = 0.0f;
+    
+    void merge_into(EmotionProfile& out) const {
+        out.primary.fear = std::max(out.primary.fear, fear);
+        out.primary.anger = std::max(out.primary.anger, anger);
+        out.primary.surprise = std::max(out.primary.surprise, surprise);
+        out.primary.joy = std::max(out.primary.joy, joy);
+        out.primary.trust = std::max(out.primary.trust, trust);
+        out.primary.sadness = std::max(out.primary.sadness, sadness);
+        out.social.anxiety = std::max(out.social.anxiety, anxiety);
+        out.social.shame = std::max(out.social.shame, shame);
+    }
+};
+
+// 广播刺激：只依赖刺激本身的评估项（每事件预计算一次）
+struct BroadcastStimulus {
+    aino_math::Vec3 position;
+    float radius = 0.0f;            // 影响半径 [m]，距离衰减同 StimulusIndex
+    float threat = 0.0f, reward = 0.0f, loss = 0.0f;   // 类别掩码 0/1
+    float intensity = 0.0f;
+    float relevance = 0.0f;         // urgency × intensity（衰减前）
+    float anger = 0.0f;             // I(1-P)/2
+    float surprise = 0.0f;          // (1-P)U
+    float controllability = 0.0f;   // 0.6P（熟悉度项由角色侧补齐）
+    
+    static BroadcastStimulus prepare(const Stimulus& s, float radius) {
+        BroadcastStimulus b;
+        StimulusCategory cat = s.resolved_category();
+        b.position = s.position;
+        b.radius = radius;
+        b.threat = cat == StimulusCategory::Threat ? 1.0f : 0.0f;
+        b.reward = cat == StimulusCategory::Reward ? 1.0f : 0.0f;
+        b.loss = cat == StimulusCategory::Loss ? 1.0f : 0.0f;
+        b.intensity = s.intensity;
+        b.relevance = s.urgency * s.intensity;
+        b.anger = s.intensity * (1.0f - s.predictability) * 0.5f;
+        b.surprise = (1.0f - s.predictability) * s.urgency;
+        b.controllability = s.predictability * 0.6f;
+        return b;
+    }
+};
+
+// 人群评估状态（SoA）：角色侧特质 + 评估输出
+//   熟悉度随观察者而异，由角色列提供（替代刺激自带的 familiarity）
+struct CrowdAppraisal {
+    std::vector<float> x, y, z;
+    std::vector<float> familiarity, self_efficacy, self_esteem, stress;
+    std::vector<float> fear, anger, surprise, joy, trust, sadness, anxiety, shame;
+    
+    [[nodiscard]] size_t size() const { return x.size(); }
+    
+    void resize(size_t n) {
+        for(auto* col : {&x, &y, &z, &familiarity, &self_efficacy, &self_esteem, &stress}) {
+            col->resize(n, 0.0f);
+        }
+        for(auto* col : outputs()) col->resize(n, 0.0f);
+    }
+    
+    void set_actor(size_t i, const aino_math::Vec3& pos, const AppraisalTraits& t, float fam = 0.5f) {
+        x[i] = pos.x; y[i] = pos.y; z[i] = pos.z;
+        familiarity[i] = fam;
+        self_efficacy[i] = t.self_efficacy;
+        self_esteem[i] = t.self_esteem;
+        stress[i] = t.stress;
+    }
+    
+    void clear_output() {
+        for(auto* col : outputs()) std::fill(col->begin(), col->end(), 0.0f);
+    }
+    
+    // 第 i 个角色的结果按最大值并入 out
+    void merge_into(size_t i, EmotionProfile& out) const {
+        AppraisalTerms{fear[i], anger[i], surprise[i], joy[i],
+                       trust[i], sadness[i], anxiety[i], shame[i]}.merge_into(out);
+    }
+    
+    // 角色空间网格（appraise_broadcast 按当前位置重建；哈希同 StimulusIndex）
+    struct Grid {
+        aino_math::GridHash hash;
+        std::unordered_map<uint64_t, uint32_t> cell_of;   // 格子键 → 格子序号
+        std::vector<uint32_t> actor_start;   // 格子序号 → order 区间（cells + 1）
+        std::vector<uint32_t> order;         // 按格子排列的角色下标
+        std::vector<uint32_t> actor_cell;
+        std::vector<uint32_t> event_start;   // 格子序号 → events 区间（cells + 1）
+        std::vector<uint32_t> events;        // 与格子相交的事件下标
+        std::vector<uint32_t> global;        // 无半径或覆盖格子过多的事件：作用于所有格子
+        
+        [[nodiscard]] size_t cell_count() const { return cell_of.size(); }
+    } grid;
+    
+    // 计数排序：O(角色数) 建格
+    void build_grid(float cell) {
+        const size_t n = size();
+        grid.hash.cell_size = cell;
+        grid.cell_of.clear();
+        grid.actor_start.assign(1, 0);
+        grid.actor_cell.resize(n);
+        grid.order.resize(n);
+        for(size_t i = 0; i < n; ++i) {
+            auto [it, inserted] = grid.cell_of.try_emplace(grid.hash.key({x[i], y[i], z[i]}),
+                                                           (uint32_t)grid.cell_of.size());
+            if(inserted) grid.actor_start.push_back(0);
+            grid.actor_cell[i] = it->second;
+            ++grid.actor_start[it->second + 1];
+        }
+        for(size_t c = 1; c < grid.actor_start.size(); ++c) grid.actor_start[c] += grid.actor_start[c - 1];
+        std::vector<uint32_t> fill(grid.actor_start.begin(), grid.actor_start.end() - 1);
+        for(size_t i = 0; i < n; ++i) grid.order[fill[grid.actor_cell[i]]++] = (uint32_t)i;
+    }
+    
+    // 事件按包围盒登记到相交的已占用格子（CSR，两遍）
+    template<typename Event>
+    void bin_events(const Event* ev, size_t event_count) {
+        const size_t cells = grid.cell_count();
+        grid.global.clear();
+        grid.event_start.assign(cells + 1, 0);
+        
+        auto visit = [&](const Event& e, auto&& fn) {
+            const auto& h = grid.hash;
+            const float r = e.radius;
+            const int x0 = h.coord(e.position.x - r), x1 = h.coord(e.position.x + r);
+            const int y0 = h.coord(e.position.y - r), y1 = h.coord(e.position.y + r);
+            const int z0 = h.coord(e.position.z - r), z1 = h.coord(e.position.z + r);
+            for(int cx = x0; cx <= x1; ++cx)
+                for(int cy = y0; cy <= y1; ++cy)
+                    for(int cz = z0; cz <= z1; ++cz) {
+                        auto it = grid.cell_of.find(aino_math::GridHash::pack(cx, cy, cz));
+                        if(it != grid.cell_of.end()) fn(it->second);
+                    }
+        };
+        // 覆盖格子数多于已占用格子时，逐格查表不如直接全量
+        auto spans_all = [&](const Event& e) {
+            if(e.radius <= 0.0f) return true;
+            const float span = 2.0f * e.radius / grid.hash.cell_size + 1.0f;
+            return span * span * span > (float)cells;
+        };
+        
+        for(size_t e = 0; e < event_count; ++e) {
+            if(spans_all(ev[e])) { grid.global.push_back((uint32_t)e); continue; }
+            visit(ev[e], [&](uint32_t c) { ++grid.event_start[c + 1]; });
+        }
+        for(size_t c = 1; c <= cells; ++c) grid.event_start[c] += grid.event_start[c - 1];
+        grid.events.resize(grid.event_start[cells]);
+        std::vector<uint32_t> fill(grid.event_start.begin(), grid.event_start.end() - 1);
+        for(size_t e = 0; e < event_count; ++e) {
+            if(spans_all(ev[e])) continue;
+            visit(ev[e], [&](uint32_t c) { grid.events[fill[c]++] = (uint32_t)e; });
+        }
+    }
+    
+private:
+    std::array<std::vector<float>*, 8> outputs() {
+        return {&fear, &anger, &surprise, &joy, &trust, &sadness, &anxiety, &shame};
+    }
 };
 
 // Lazarus认知评价器
@@ -33,17 +287,21 @@ public:
     EmotionProfile::Primary primary_appraisal(const Stimulus& stim) const {
         EmotionProfile::Primary prim;
         
-        if(stim.category == "threat" || stim.category == "enemy") {
-            prim.fear = stim.intensity * (2.0f - stim.familiarity);
-            prim.anger = stim.intensity * (1.0f - stim.predictability) * 0.5f;
-            prim.surprise = (1.0f - stim.predictability) * stim.urgency;
-        }
-        else if(stim.category == "reward" || stim.category == "friend") {
-            prim.joy = stim.intensity;
-            prim.trust = stim.intensity * stim.familiarity;
-        }
-        else if(stim.category == "loss") {
-            prim.sadness = stim.intensity;
+        switch(stim.resolved_category()) {
+            case StimulusCategory::Threat:
+                prim.fear = stim.intensity * (2.0f - stim.familiarity);
+                prim.anger = stim.intensity * (1.0f - stim.predictability) * 0.5f;
+                prim.surprise = (1.0f - stim.predictability) * stim.urgency;
+                break;
+            case StimulusCategory::Reward:
+                prim.joy = stim.intensity;
+                prim.trust = stim.intensity * stim.familiarity;
+                break;
+            case StimulusCategory::Loss:
+                prim.sadness = stim.intensity;
+                break;
+            default:
+                break;
         }
         
         return prim;
@@ -55,7 +313,7 @@ public:
         auto it = ctx.parameters.find("self_efficacy");
         if(it != ctx.parameters.end()) self_efficacy = it->second;
         
-        float resource = 1.0f - ctx.emotion.mood.stress * 0.5f;
+        float resource = 1.0f - ctx.emotion.stress * 0.5f;
         float controllability = stim.predictability * 0.6f + stim.familiarity * 0.4f;
         return self_efficacy * resource * controllability;
     }
@@ -76,7 +334,7 @@ public:
         }
         
         // 心境调制
-        output.emotion.primary.fear *= (1.0f + ctx.emotion.mood.stress * 0.5f);
+        output.emotion.primary.fear *= (1.0f + ctx.emotion.stress * 0.5f);
         
         // 目标相关性
         output.goal_relevance = stim.urgency * stim.intensity;
@@ -86,6 +344,134 @@ public:
         
         return output;
     }
+    
+    // 单刺激评估项（批量内核共用；相关性不足时全部为0）
+    static AppraisalTerms stimulus_terms(StimulusCategory cat, float I, float U, float F, float P,
+                                         const AppraisalTraits& traits) {
+        // 1. 类别/相关性掩码
+        float relevant = (U * I > 0.2f) ? 1.0f : 0.0f;
+        float threat = cat == StimulusCategory::Threat ? relevant : 0.0f;
+        float reward = cat == StimulusCategory::Reward ? relevant : 0.0f;
+        float loss = cat == StimulusCategory::Loss ? relevant : 0.0f;
+        float unpredictable = 1.0f - P;
+        
+        // 2. 初级评估（含心境调制）
+        AppraisalTerms t;
+        t.fear = threat * I * (2.0f - F) * (1.0f + traits.stress * 0.5f);
+        t.anger = threat * I * unpredictable * 0.5f;
+        t.surprise = threat * unpredictable * U;
+        t.joy = reward * I;
+        t.trust = reward * I * F;
+        t.sadness = loss * I;
+        
+        // 3. 次级评估：应对不足 → 焦虑/羞耻
+        float coping = traits.self_efficacy * (1.0f - traits.stress * 0.5f) * (P * 0.6f + F * 0.4f);
+        float helpless = (coping < 0.3f && I > 0.6f) ? relevant : 0.0f;
+        t.anxiety = helpless * (1.0f - coping) * I;
+        t.shame = helpless * (1.0f - traits.self_esteem) * I;
+        return t;
+    }
+    
+    // 批量评估：单次遍历全部刺激，相关刺激（goal_relevance > 0.2）按最大值并入 out
+    // 与逐刺激 appraise 结果一致；无分支，便于编译器向量化
+    void appraise_batch(const StimulusBatch& batch, const AppraisalTraits& traits,
+                        EmotionProfile& out) const {
+        AINO_ZONE("appraiser.appraise_batch");
+        const size_t count = batch.size();
+        const StimulusCategory* cat = batch.category.data();
+        const float* I = batch.intensity.data();
+        const float* U = batch.urgency.data();
+        const float* F = batch.familiarity.data();
+        const float* P = batch.predictability.data();
+        
+        float fear = 0.0f, anger = 0.0f, surprise = 0.0f, joy = 0.0f;
+        float trust = 0.0f, sadness = 0.0f, anxiety = 0.0f, shame = 0.0f;
+        
+        #pragma omp simd reduction(max:fear,anger,surprise,joy,trust,sadness,anxiety,shame)
+        for(size_t i = 0; i < count; ++i) {
+            AppraisalTerms t = stimulus_terms(cat[i], I[i], U[i], F[i], P[i], traits);
+            fear = std::max(fear, t.fear);
+            anger = std::max(anger, t.anger);
+            surprise = std::max(surprise, t.surprise);
+            joy = std::max(joy, t.joy);
+            trust = std::max(trust, t.trust);
+            sadness = std::max(sadness, t.sadness);
+            anxiety = std::max(anxiety, t.anxiety);
+            shame = std::max(shame, t.shame);
+        }
+        
+        AppraisalTerms{fear, anger, surprise, joy, trust, sadness, anxiety, shame}.merge_into(out);
+    }
+    
+    // 人群批量评估：每角色一个刺激批
+    void appraise_crowd(const StimulusBatch* batches, const AppraisalTraits* traits,
+                        EmotionProfile* out, size_t actor_count) const {
+        #pragma omp parallel for schedule(dynamic, 16)
+        for(size_t a = 0; a < actor_count; ++a) {
+            appraise_batch(batches[a], traits[a], out[a]);
+        }
+    }
+    
+    // 广播评估：刺激侧已预计算，角色侧仅做距离衰减 + 特质调制（连续列上的乘加）
+    // 结果按最大值累积到 crowd 的输出列，与逐角色 appraise_batch 一致
+    void appraise_broadcast(const BroadcastStimulus* events, size_t event_count,
+                            CrowdAppraisal& crowd) const {
+        const float *X = crowd.x.data(), *Y = crowd.y.data(), *Z = crowd.z.data();
+        const float *F = crowd.familiarity.data(), *SE = crowd.self_efficacy.data();
+        const float *ES = crowd.self_esteem.data(), *ST = crowd.stress.data();
+        float *fear = crowd.fear.data(), *anger = crowd.anger.data(), *surprise = crowd.surprise.data();
+        float *joy = crowd.joy.data(), *trust = crowd.trust.data(), *sadness = crowd.sadness.data();
+        float *anxiety = crowd.anxiety.data(), *shame = crowd.shame.data();
+        
+        // 1. 网格剔除：格子边长取最大有限半径（每个事件最多跨 3×3×3 格），只评估相交格子内的角色
+        float cell = 1.0f;
+        for(size_t e = 0; e < event_count; ++e) cell = std::max(cell, events[e].radius);
+        crowd.build_grid(cell);
+        crowd.bin_events(events, event_count);
+        const auto& grid = crowd.grid;
+        const uint32_t *order = grid.order.data();
+        
+        auto apply = [&](const BroadcastStimulus& ev, uint32_t begin, uint32_t end) {
+            const float inv_r2 = ev.radius > 0.0f ? 1.0f / (ev.radius * ev.radius) : 0.0f;
+            #pragma omp simd
+            for(uint32_t s = begin; s < end; ++s) {
+                const uint32_t i = order[s];
+                // 2. 距离衰减 (1 - d²/r²)²
+                float dx = X[i] - ev.position.x, dy = Y[i] - ev.position.y, dz = Z[i] - ev.position.z;
+                float q = std::max(1.0f - (dx * dx + dy * dy + dz * dz) * inv_r2, 0.0f);
+                float w = q * q;
+                
+                // 3. 相关性：衰减后 urgency × intensity 按 w² 缩放
+                float relevant = (w * w * ev.relevance > 0.2f) ? w : 0.0f;
+                float I = ev.intensity * w;
+                float threat = ev.threat * relevant, reward = ev.reward * relevant;
+                
+                // 4. 角色调制
+                fear[i] = std::max(fear[i], threat * ev.intensity * (2.0f - F[i]) * (1.0f + ST[i] * 0.5f));
+                anger[i] = std::max(anger[i], threat * ev.anger);
+                surprise[i] = std::max(surprise[i], threat * ev.surprise);
+                joy[i] = std::max(joy[i], reward * ev.intensity);
+                trust[i] = std::max(trust[i], reward * ev.intensity * F[i]);
+                sadness[i] = std::max(sadness[i], ev.loss * relevant * ev.intensity);
+                
+                float coping = SE[i] * (1.0f - ST[i] * 0.5f) * (ev.controllability + F[i] * 0.4f);
+                float helpless = (coping < 0.3f && I > 0.6f && relevant > 0.0f) ? I : 0.0f;
+                anxiety[i] = std::max(anxiety[i], helpless * (1.0f - coping));
+                shame[i] = std::max(shame[i], helpless * (1.0f - ES[i]));
+            }
+        };
+        
+        // 5. 单个并行区按格子划分：每个角色只由一个线程写入
+        const size_t cells = grid.cell_count();
+        #pragma omp parallel for schedule(dynamic, 8)
+        for(size_t c = 0; c < cells; ++c) {
+            const uint32_t begin = grid.actor_start[c], end = grid.actor_start[c + 1];
+            for(uint32_t k = grid.event_start[c]; k < grid.event_start[c + 1]; ++k) {
+                apply(events[grid.events[k]], begin, end);
+            }
+            for(uint32_t e : grid.global) apply(events[e], begin, end);
+        }
+    }
 };
 
 } // namespace psychology
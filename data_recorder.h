@@ -7,9 +7,15 @@
 #include <string>
 #include <stdexcept>
 #include <chrono>
+#include <mutex>
 
-// HDF5 依赖（需要链接 -lhdf5）
+// HDF5 依赖（需要链接 -lhdf5）；未找到时仅保留内存采集，start_session 报错
+#if !defined(AINO_WITH_HDF5) && __has_include(<hdf5.h>)
+#define AINO_WITH_HDF5 1
+#endif
+#if AINO_WITH_HDF5
 #include <hdf5.h>
+#endif
 
 namespace aino_pro {
 namespace systems {
@@ -20,12 +26,18 @@ struct TrainingSample {
     std::vector<float> metabolism_state;    // 5D
     std::vector<float> muscle_activations;  // 50D
     std::vector<uint16_t> pose_quantized;   // 256D
+    
+    // 代理模型训练用（learning::SurrogateTrainer）
+    std::vector<float> desired_torques;     // 每关节
+    std::vector<float> stimulus_features;   // 4D
+    std::vector<float> joint_angles;        // 每关节Z轴
 };
 
 class DataRecorder {
     std::vector<TrainingSample> buffer;
     static constexpr size_t BUFFER_SIZE = 1024;
     
+#if AINO_WITH_HDF5
     // HDF5 资源管理
     struct HDF5File {
         hid_t id = -1;
@@ -34,9 +46,20 @@ class DataRecorder {
     
     hid_t emotion_dset = -1, metabolism_dset = -1, muscle_dset = -1, pose_dset = -1;
     hsize_t current_row = 0;
+#endif
+    
+    // 内存采集（供代理模型离线训练）
+    bool capture_enabled = false;
+    std::vector<TrainingSample> captured;
+    
+    // 多个工作线程共享同一记录器
+    std::mutex record_mutex;
 
 public:
     void start_session(const std::string& filename) {
+#if !AINO_WITH_HDF5
+        throw std::runtime_error("Built without HDF5, cannot record to: " + filename);
+#else
         file_handle.id = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
         if(file_handle.id < 0) {
             throw std::runtime_error("Failed to create HDF5 file: " + filename);
@@ -57,9 +80,12 @@ public:
         buffer.reserve(BUFFER_SIZE);
         H5Sclose(space);
         H5Pclose(dcpl);
+#endif
     }
     
     void record_frame(const TrainingSample& sample) {
+        std::lock_guard<std::mutex> lock(record_mutex);
+        if(capture_enabled) captured.push_back(sample);
         buffer.push_back(sample);
         if(buffer.size() >= BUFFER_SIZE) {
             flush_to_disk();
@@ -68,6 +94,7 @@ public:
     }
     
     void flush_to_disk() {
+#if AINO_WITH_HDF5
         if(buffer.empty() || emotion_dset < 0) return;
         
         // 追加写入（简化示例：只写情感数据）
@@ -89,8 +116,13 @@ public:
         current_row += buffer.size();
         H5Sclose(mem_space);
         H5Sclose(file_space);
+#endif
     }
     
+    void enable_capture(bool enabled) { capture_enabled = enabled; }
+    [[nodiscard]] const std::vector<TrainingSample>& get_captured() const { return captured; }
+    void clear_captured() { captured.clear(); }
+    
     ~DataRecorder() {
         flush_to_disk();
     }
@@ -0,0 +1,157 @@
+// =====================================================
+// aino_pro/systems/emotion_contagion.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include "../aino_math.hpp"
+#include "../psychology/emotion_model.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+struct ContagionParams {
+    float radius = 3.0f;            // 感染半径 [m]
+    float rate = 2.0f;              // 趋近邻居情绪的速率 [1/s]
+    float transmission = 0.8f;      // 传递衰减（<1，防止邻居间互相维持）
+    // 可传染分量（EmotionProfile::components 下标）：喜、悲、怒、惧、惊、厌、焦虑
+    std::vector<size_t> components = {0, 1, 2, 3, 4, 5, 15};
+};
+
+// 人群情绪传染
+//   地面(x, z)均匀网格 + 计数排序：邻居扫描在排序后的连续内存上进行
+//   双缓冲（读 in 写 out），每角色按固定顺序累加，结果与线程数无关
+class EmotionContagion {
+    ContagionParams params;
+    
+    // 网格
+    float min_x = 0.0f, min_z = 0.0f, cell = 1.0f;
+    int nx = 0, nz = 0;
+    std::vector<uint32_t> cell_of;      // 角色 → 格子
+    std::vector<uint32_t> cell_start;   // 格子 → 排序后起始下标（nx*nz + 1）
+    std::vector<uint32_t> order;        // 排序后下标 → 角色
+    
+    // 按格子排序后的位置与可传染分量（分量按行紧排：一个邻居一条缓存行）
+    std::vector<float> sorted_x, sorted_z;
+    std::vector<float> sorted_emotion;  // [排序下标 × 分量数]
+    
+public:
+    explicit EmotionContagion(const ContagionParams& p = ContagionParams()) : params(p) {}
+    
+    [[nodiscard]] const ContagionParams& get_params() const { return params; }
+    void set_params(const ContagionParams& p) { params = p; }
+    
+    // positions[i] 与 in/out 第 i 行对应；susceptibility 可为空（= 1）
+    void step(const aino_math::Vec3* positions, const float* susceptibility,
+              const psychology::EmotionBank& in, psychology::EmotionBank& out, float dt) {
+        const size_t n = in.size();
+        out = in;
+        if(n == 0 || params.radius <= 0.0f) return;
+        
+        build_grid(positions, n);
+        gather_sorted(positions, in);
+        
+        const float inv_r2 = 1.0f / (params.radius * params.radius);
+        const float gain = std::clamp(params.rate * dt, 0.0f, 1.0f);
+        const size_t comp_count = params.components.size();
+        
+        #pragma omp parallel
+        {
+            std::vector<float> influence(comp_count);
+            
+            #pragma omp for schedule(static)
+            for(size_t s = 0; s < n; ++s) {
+                const uint32_t self = order[s];
+                const float px = sorted_x[s], pz = sorted_z[s];
+                const int cx = int(cell_of[self] % nx), cz = int(cell_of[self] / nx);
+                
+                // 1. 3×3邻域加权累加（距离衰减 (1 - d²/r²)²）
+                //    格子按行优先排序，同一行的3个格子在排序后是一段连续区间
+                std::fill(influence.begin(), influence.end(), 0.0f);
+                float total = 0.0f;
+                const int x0 = std::max(cx - 1, 0), x1 = std::min(cx + 1, nx - 1);
+                for(int z = std::max(cz - 1, 0); z <= std::min(cz + 1, nz - 1); ++z) {
+                    const uint32_t begin = cell_start[z * nx + x0], end = cell_start[z * nx + x1 + 1];
+                    for(uint32_t j = begin; j < end; ++j) {
+                        if(j == s) continue;
+                        float dx = sorted_x[j] - px, dz = sorted_z[j] - pz;
+                        float q = std::max(1.0f - (dx * dx + dz * dz) * inv_r2, 0.0f);
+                        float w = q * q;
+                        total += w;
+                        const float* e = &sorted_emotion[size_t(j) * comp_count];
+                        for(size_t k = 0; k < comp_count; ++k) influence[k] += w * e[k];
+                    }
+                }
+                if(total <= 0.0f) continue;
+                
+                // 2. 只向上趋近邻居情绪（衰减由各角色自身情绪动态负责）
+                const float norm = params.transmission / std::max(total, 1.0f);
+                const float g = gain * (susceptibility ? susceptibility[self] : 1.0f);
+                for(size_t k = 0; k < comp_count; ++k) {
+                    float e = sorted_emotion[s * comp_count + k];
+                    float target = influence[k] * norm;
+                    if(target > e) out.column(params.components[k])[self] = e + (target - e) * g;
+                }
+            }
+        }
+    }
+    
+private:
+    // 计数排序建网格（稳定：同格内保持原下标顺序）
+    void build_grid(const aino_math::Vec3* positions, size_t n) {
+        float max_x = positions[0].x, max_z = positions[0].z;
+        min_x = max_x; min_z = max_z;
+        for(size_t i = 1; i < n; ++i) {
+            min_x = std::min(min_x, positions[i].x); max_x = std::max(max_x, positions[i].x);
+            min_z = std::min(min_z, positions[i].z); max_z = std::max(max_z, positions[i].z);
+        }
+        
+        // 格子数上限 4n（稀疏大世界时放大格子，保证邻域仍为3×3）
+        cell = params.radius;
+        for(;;) {
+            nx = int((max_x - min_x) / cell) + 1;
+            nz = int((max_z - min_z) / cell) + 1;
+            if(double(nx) * nz <= 4.0 * n + 16) break;
+            cell *= 2.0f;
+        }
+        
+        const size_t cell_count = size_t(nx) * nz;
+        cell_of.resize(n);
+        cell_start.assign(cell_count + 1, 0);
+        for(size_t i = 0; i < n; ++i) {
+            int x = std::min(int((positions[i].x - min_x) / cell), nx - 1);
+            int z = std::min(int((positions[i].z - min_z) / cell), nz - 1);
+            cell_of[i] = uint32_t(z * nx + x);
+            ++cell_start[cell_of[i] + 1];
+        }
+        for(size_t c = 0; c < cell_count; ++c) cell_start[c + 1] += cell_start[c];
+        
+        order.resize(n);
+        std::vector<uint32_t> cursor(cell_start.begin(), cell_start.end() - 1);
+        for(size_t i = 0; i < n; ++i) order[cursor[cell_of[i]]++] = uint32_t(i);
+    }
+    
+    void gather_sorted(const aino_math::Vec3* positions, const psychology::EmotionBank& in) {
+        const size_t n = order.size();
+        sorted_x.resize(n);
+        sorted_z.resize(n);
+        const size_t comp_count = params.components.size();
+        sorted_emotion.resize(n * comp_count);
+        
+        for(size_t s = 0; s < n; ++s) {
+            sorted_x[s] = positions[order[s]].x;
+            sorted_z[s] = positions[order[s]].z;
+        }
+        for(size_t k = 0; k < comp_count; ++k) {
+            const float* src = in.column(params.components[k]);
+            for(size_t s = 0; s < n; ++s) sorted_emotion[s * comp_count + k] = src[order[s]];
+        }
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
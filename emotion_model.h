@@ -4,6 +4,7 @@
 
 #pragma once
 #include <array>
+#include <vector>
 #include <algorithm>
 #include <cmath>
 
@@ -41,6 +42,39 @@ struct EmotionProfile {
         return (primary.anger*0.7f + primary.trust*0.5f) - (primary.fear*0.8f + primary.sadness*0.6f);
     }
     
+    // 基本 + 社会情绪分量（16维，顺序同 to_vector 前16项）
+    static constexpr size_t COMPONENT_COUNT = 16;
+    
+    [[nodiscard]] std::array<float, COMPONENT_COUNT> components() const {
+        return {
+            primary.joy, primary.sadness, primary.anger, primary.fear,
+            primary.surprise, primary.disgust, primary.trust, primary.anticipation,
+            social.guilt, social.shame, social.pride, social.envy,
+            social.gratitude, social.love, social.hate, social.anxiety
+        };
+    }
+    
+    void set_components(const std::array<float, COMPONENT_COUNT>& c) {
+        primary = {c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]};
+        social = {c[8], c[9], c[10], c[11], c[12], c[13], c[14], c[15]};
+    }
+    
+    // 情绪混合：全部16个分量取最大值
+    void blend_max(const EmotionProfile& other) {
+        auto a = components();
+        auto b = other.components();
+        for(size_t i = 0; i < COMPONENT_COUNT; ++i) a[i] = std::max(a[i], b[i]);
+        set_components(a);
+    }
+    
+    // 情绪混合：按权重插值（w = 0 保持，w = 1 替换）
+    void blend_weighted(const EmotionProfile& other, float w) {
+        auto a = components();
+        auto b = other.components();
+        for(size_t i = 0; i < COMPONENT_COUNT; ++i) a[i] += (b[i] - a[i]) * w;
+        set_components(a);
+    }
+    
     // 序列化（30维向量）
     [[nodiscard]] std::array<float, 30> to_vector() const {
         return {
@@ -54,6 +88,123 @@ struct EmotionProfile {
     }
 };
 
+// 人群情绪库（SoA：每个分量一列，每个角色一行）
+//   混合/衰减/PAD投影都是整列的连续运算，按带宽而非调用次数计费
+class EmotionBank {
+public:
+    static constexpr size_t COMPONENTS = EmotionProfile::COMPONENT_COUNT;
+    static constexpr size_t MOOD_COMPONENTS = 4;   // depression, stress, valence, arousal
+    static constexpr size_t PAD_INPUTS = COMPONENTS + MOOD_COMPONENTS;
+    
+    // PAD投影矩阵（与 EmotionProfile::pleasure/arousal/dominance 一致）
+    static constexpr std::array<std::array<float, PAD_INPUTS>, 3> PAD_WEIGHTS = {{
+        //  joy  sad  ang  fear sur  dis  tru  ant  | social x8              | dep  str  val  aro
+        {{ 0,   0,   0,   0,   0,   0,   0,   0,     0, 0, 0, 0, 0, 0, 0, 0,  0,   0,   1,   0 }},  // pleasure
+        {{ .3f, 0,   .8f, .9f, 0,   0,   0,   0,     0, 0, 0, 0, 0, 0, 0, 0,  0,   0,   0,   1 }},  // arousal
+        {{ 0,  -.6f, .7f,-.8f, 0,   0,   .5f, 0,     0, 0, 0, 0, 0, 0, 0, 0,  0,   0,   0,   0 }}   // dominance
+    }};
+    
+private:
+    size_t count = 0;
+    std::array<std::vector<float>, COMPONENTS> emotion;
+    std::array<std::vector<float>, MOOD_COMPONENTS> mood;
+    std::array<std::vector<float>, 3> pad;
+    
+public:
+    explicit EmotionBank(size_t n = 0) { resize(n); }
+    
+    [[nodiscard]] size_t size() const { return count; }
+    
+    void resize(size_t n) {
+        count = n;
+        for(auto& c : emotion) c.resize(n, 0.0f);
+        for(auto& c : mood) c.resize(n, 0.0f);
+        for(auto& c : pad) c.resize(n, 0.0f);
+    }
+    
+    [[nodiscard]] float* column(size_t component) { return emotion[component].data(); }
+    [[nodiscard]] const float* column(size_t component) const { return emotion[component].data(); }
+    [[nodiscard]] const float* pleasure() const { return pad[0].data(); }
+    [[nodiscard]] const float* arousal() const { return pad[1].data(); }
+    [[nodiscard]] const float* dominance() const { return pad[2].data(); }
+    
+    // AoS ↔ SoA
+    void store(size_t i, const EmotionProfile& e) {
+        auto c = e.components();
+        for(size_t k = 0; k < COMPONENTS; ++k) emotion[k][i] = c[k];
+        mood[0][i] = e.mood.depression;
+        mood[1][i] = e.mood.stress;
+        mood[2][i] = e.mood.valence;
+        mood[3][i] = e.mood.arousal;
+    }
+    
+    void load(size_t i, EmotionProfile& e) const {
+        std::array<float, COMPONENTS> c;
+        for(size_t k = 0; k < COMPONENTS; ++k) c[k] = emotion[k][i];
+        e.set_components(c);
+        e.mood = {mood[0][i], mood[1][i], mood[2][i], mood[3][i]};
+    }
+    
+    // 第 i 行按最大值并入单个角色情绪（心境不变）
+    void merge_row_max(size_t i, EmotionProfile& e) const {
+        auto c = e.components();
+        for(size_t k = 0; k < COMPONENTS; ++k) c[k] = std::max(c[k], emotion[k][i]);
+        e.set_components(c);
+    }
+    
+    // 整库最大值混合（src 行数须相同）
+    void blend_max(const EmotionBank& src) {
+        for(size_t k = 0; k < COMPONENTS; ++k) {
+            float* a = emotion[k].data();
+            const float* b = src.emotion[k].data();
+            #pragma omp simd
+            for(size_t i = 0; i < count; ++i) a[i] = std::max(a[i], b[i]);
+        }
+    }
+    
+    // 整库加权混合：a += (b - a) * w[i]（w 为每角色权重）
+    void blend_weighted(const EmotionBank& src, const float* w) {
+        for(size_t k = 0; k < COMPONENTS; ++k) {
+            float* a = emotion[k].data();
+            const float* b = src.emotion[k].data();
+            #pragma omp simd
+            for(size_t i = 0; i < count; ++i) a[i] += (b[i] - a[i]) * w[i];
+        }
+    }
+    
+    // 指数衰减（所有分量乘同一因子）
+    void decay(float factor) {
+        for(auto& col : emotion) {
+            float* a = col.data();
+            #pragma omp simd
+            for(size_t i = 0; i < count; ++i) a[i] *= factor;
+        }
+    }
+    
+    // PAD = W · [情绪; 心境]，按列累加，跳过零权重
+    void project_pad() {
+        for(size_t r = 0; r < 3; ++r) {
+            float* out = pad[r].data();
+            std::fill(out, out + count, 0.0f);
+            for(size_t k = 0; k < PAD_INPUTS; ++k) {
+                const float w = PAD_WEIGHTS[r][k];
+                if(w == 0.0f) continue;
+                const float* in = k < COMPONENTS ? emotion[k].data() : mood[k - COMPONENTS].data();
+                #pragma omp simd
+                for(size_t i = 0; i < count; ++i) out[i] += w * in[i];
+            }
+        }
+    }
+    
+    // 第 i 行的30维向量（需先 project_pad）
+    void write_vector(size_t i, float* out) const {
+        for(size_t k = 0; k < COMPONENTS; ++k) out[k] = emotion[k][i];
+        for(size_t k = 0; k < MOOD_COMPONENTS; ++k) out[COMPONENTS + k] = mood[k][i];
+        for(size_t r = 0; r < 3; ++r) out[PAD_INPUTS + r] = pad[r][i];
+        std::fill(out + PAD_INPUTS + 3, out + 30, 0.0f);
+    }
+};
+
 // 心境动态系统（情绪记忆与衰减）
 class MoodDynamics {
     float depression_accumulator = 0.0f;
@@ -94,6 +245,18 @@ public:
             stress_accumulator * 0.3f
         };
     }
+    
+    // 可积分状态（存档 / 并行时间积分用）
+    static constexpr size_t STATE_SIZE = 2;
+    
+    [[nodiscard]] std::array<float, STATE_SIZE> save_state() const {
+        return {depression_accumulator, stress_accumulator};
+    }
+    
+    void restore_state(const std::array<float, STATE_SIZE>& s) {
+        depression_accumulator = std::clamp(s[0], 0.0f, 1.0f);
+        stress_accumulator = std::clamp(s[1], 0.0f, 1.0f);
+    }
 };
 
 } // namespace psychology
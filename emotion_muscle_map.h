@@ -0,0 +1,152 @@
+// =====================================================
+// aino_pro/systems/emotion_muscle_map.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <array>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <cstdint>
+#include "../psychology/emotion_model.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 情绪 → 肌肉激活偏置（CSR稀疏矩阵，行 = 肌肉，列 = 情绪输入）
+//   输入列顺序同 EmotionBank：16个情绪分量 + 4个心境分量
+class EmotionMuscleMap {
+public:
+    static constexpr size_t INPUT_COUNT = psychology::EmotionBank::PAD_INPUTS;
+    
+    struct Entry {
+        uint32_t muscle;
+        uint32_t input;
+        float weight;
+    };
+    
+private:
+    size_t muscle_count = 0;
+    std::vector<uint32_t> row_start;    // muscle_count + 1
+    std::vector<uint32_t> columns;
+    std::vector<float> weights;
+    
+public:
+    EmotionMuscleMap() = default;
+    
+    // 三元组构建（同一位置重复项累加）
+    explicit EmotionMuscleMap(std::vector<Entry> entries) {
+        for(const auto& e : entries) {
+            if(e.input >= INPUT_COUNT) throw std::runtime_error("Emotion input index out of range");
+            muscle_count = std::max<size_t>(muscle_count, e.muscle + 1);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.muscle != b.muscle ? a.muscle < b.muscle : a.input < b.input;
+        });
+        
+        row_start.assign(muscle_count + 1, 0);
+        for(size_t k = 0; k < entries.size(); ++k) {
+            const auto& e = entries[k];
+            if(k > 0 && e.muscle == entries[k - 1].muscle && e.input == entries[k - 1].input) {
+                weights.back() += e.weight;
+                continue;
+            }
+            columns.push_back(e.input);
+            weights.push_back(e.weight);
+            ++row_start[e.muscle + 1];
+        }
+        for(size_t m = 0; m < muscle_count; ++m) row_start[m + 1] += row_start[m];
+    }
+    
+    static constexpr long long MAX_MUSCLES = 65536;
+    
+    // 文本格式：每行 "<肌肉下标> <情绪名> <权重>"，# 起注释；任何格式错误均抛出 路径:行号
+    static EmotionMuscleMap load(const std::string& path) {
+        std::ifstream f(path);
+        if(!f) throw std::runtime_error("Failed to open emotion map: " + path);
+        
+        std::vector<Entry> entries;
+        std::string line;
+        int line_no = 0;
+        auto fail = [&](const std::string& what) {
+            return std::runtime_error(path + ":" + std::to_string(line_no) + ": " + what);
+        };
+        while(std::getline(f, line)) {
+            ++line_no;
+            line = line.substr(0, line.find('#'));
+            std::istringstream in(line);
+            if((in >> std::ws).eof()) continue; // 空行 / 纯注释
+            
+            long long muscle;
+            std::string name, extra;
+            float weight;
+            if(!(in >> muscle >> name >> weight) || (in >> extra)) {
+                throw fail("expected <muscle> <emotion> <weight>");
+            }
+            if(muscle < 0 || muscle >= MAX_MUSCLES) throw fail("muscle index out of range: " + std::to_string(muscle));
+            if(!std::isfinite(weight)) throw fail("non-finite weight");
+            uint32_t input;
+            try {
+                input = input_index(name);
+            } catch(const std::runtime_error& e) {
+                throw fail(e.what());
+            }
+            entries.push_back({(uint32_t)muscle, input, weight});
+        }
+        return EmotionMuscleMap(std::move(entries));
+    }
+    
+    // 内置默认：恐惧 → 斜方肌，悲伤 → 腹直肌
+    static const EmotionMuscleMap& default_map() {
+        static const EmotionMuscleMap map({
+            {0, input_index("fear"), 0.7f},
+            {1, input_index("sadness"), 0.6f}
+        });
+        return map;
+    }
+    
+    static uint32_t input_index(const std::string& name) {
+        static const std::array<const char*, INPUT_COUNT> NAMES = {
+            "joy", "sadness", "anger", "fear", "surprise", "disgust", "trust", "anticipation",
+            "guilt", "shame", "pride", "envy", "gratitude", "love", "hate", "anxiety",
+            "depression", "stress", "valence", "arousal"
+        };
+        for(uint32_t i = 0; i < INPUT_COUNT; ++i) {
+            if(name == NAMES[i]) return i;
+        }
+        throw std::runtime_error("Unknown emotion input: " + name);
+    }
+    
+    [[nodiscard]] size_t rows() const { return muscle_count; }
+    [[nodiscard]] size_t nonzeros() const { return weights.size(); }
+    
+    // SpMV：out[m] = Σ W[m][k]·x[k]（超出矩阵行数的输出置0）
+    void apply(const float* x, float* out, size_t out_count) const {
+        const size_t rows_used = std::min(muscle_count, out_count);
+        for(size_t m = 0; m < rows_used; ++m) {
+            float sum = 0.0f;
+            for(uint32_t k = row_start[m]; k < row_start[m + 1]; ++k) sum += weights[k] * x[columns[k]];
+            out[m] = sum;
+        }
+        std::fill(out + rows_used, out + out_count, 0.0f);
+    }
+    
+    void apply(const psychology::EmotionProfile& e, std::vector<float>& out) const {
+        std::array<float, INPUT_COUNT> x;
+        auto c = e.components();
+        std::copy(c.begin(), c.end(), x.begin());
+        constexpr size_t M = psychology::EmotionBank::COMPONENTS;
+        x[M + 0] = e.mood.depression;
+        x[M + 1] = e.mood.stress;
+        x[M + 2] = e.mood.valence;
+        x[M + 3] = e.mood.arousal;
+        apply(x.data(), out.data(), out.size());
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
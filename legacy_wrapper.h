@@ -14,22 +14,46 @@ class LegacyToProAdapter : public aino_animation::AnimationNodeBase {
     std::shared_ptr<aino_animation::AnimationNodeBase> legacy_node;
     systems::PhysiologicalActor* actor = nullptr;
     
+    // 预分配扭矩缓冲（按骨骼数复用），桥接的扭矩通道在构造时绑定一次
+    std::vector<float> torques;
+    systems::PhysioBridge bridge;
+    uint64_t extracted_version = 0; // 上次提取扭矩时的姿态版本
+    
 public:
     explicit LegacyToProAdapter(std::shared_ptr<aino_animation::AnimationNodeBase> node)
-        : legacy_node(std::move(node)) {}
+        : legacy_node(std::move(node)) {
+        bridge.torque_channel.bind(torques);
+    }
+    
+    LegacyToProAdapter(const LegacyToProAdapter&) = delete;
+    LegacyToProAdapter& operator=(const LegacyToProAdapter&) = delete;
+    
+    void bind_actor(systems::PhysiologicalActor* a) {
+        actor = a;
+        mark_dirty();
+    }
+    
+    // 未绑定角色时仅做姿态转换，可随原版节点一起复用缓存
+    [[nodiscard]] bool is_static() const override { return actor == nullptr; }
+    [[nodiscard]] bool is_idempotent() const override { return legacy_node->is_idempotent(); }
     
-    void bind_actor(systems::PhysiologicalActor* a) { actor = a; }
+    // 上游扭矩输出（供其他节点绑定）
+    [[nodiscard]] const std::vector<float>& torque_output() const { return torques; }
     
 protected:
     void on_evaluate(aino_animation::AnimationContext& ctx) override {
         // 1. 运行原版逻辑
         legacy_node->evaluate(ctx);
         
-        // 2. 提取扭矩数据
-        if(actor && ctx.output) {
-            systems::PhysioBridge bridge;
-            bridge.desired_joint_torques = extract_torques_from_pose(ctx.output);
-            
+        if(!ctx.output) return;
+        
+        // 2. 提取扭矩数据（写入复用缓冲，下游节点可绑定 torque_output；原版姿态未变则跳过）
+        if(ctx.output->version != extracted_version) {
+            extract_torques_from_pose(*ctx.output);
+            extracted_version = ctx.output->version;
+        }
+        
+        if(actor) {
             // 3. 更新生理
             actor->update(ctx.delta_time, bridge);
             
@@ -38,14 +62,17 @@ protected:
         }
     }
     
+    [[nodiscard]] bool inputs_unchanged() const override {
+        return legacy_node->unchanged() && AnimationNodeBase::inputs_unchanged();
+    }
+    
 private:
-    std::vector<float> extract_torques_from_pose(aino_animation::PoseBuffer* pose) {
-        std::vector<float> torques(pose->bone_count, 0.0f);
-        for(size_t i = 0; i < pose->bone_count; ++i) {
+    void extract_torques_from_pose(const aino_animation::PoseBuffer& pose) {
+        torques.resize(pose.bone_count); // 骨骼数不变时不重新分配
+        for(size_t i = 0; i < pose.bone_count; ++i) {
             // 简化：从Z旋转角度估算扭矩
-            torques[i] = pose->rotation_z[i] * 10.0f;
+            torques[i] = pose.rotation_z[i] * 10.0f;
         }
-        return torques;
     }
 };
 
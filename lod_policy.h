@@ -0,0 +1,111 @@
+// =====================================================
+// aino_pro/systems/lod_policy.hpp
+// =====================================================
+
+#pragma once
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "../aino_math.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 肌肉模型档位
+enum class MuscleModel {
+    Huxley,      // 完整横桥网格（截止时间内精算）
+    Moment,      // 粗分箱估计（组数与网格无关，不精算）
+    Surrogate,   // 神经代理（未绑定时退化为Moment）
+    Baked        // 烘焙回放（不跑肌肉/骨骼）
+};
+
+// 单个LOD档位
+struct LodLevel {
+    MuscleModel muscle_model = MuscleModel::Huxley;
+    int grid_size = 0;             // Huxley网格分辨率（0 = 跟随全局Accuracy）
+    float fiber_fraction = 1.0f;   // 参与计算的纤维比例
+    int update_interval = 1;       // 每N帧更新一次（累积dt）
+    
+    // 子系统开关（与全局FeatureFlags取交集）
+    bool run_emotion = true;
+    bool run_neural = true;
+    bool run_tendons = true;
+    bool run_metabolism = true;
+};
+
+// 每帧LOD输入
+struct LodInput {
+    float camera_distance = 0.0f;  // [m]
+    float screen_coverage = 1.0f;  // 0-1 屏幕占比
+    float importance = 1.0f;       // 剧情/玩家相关性提示（>1提升精度）
+    
+    // 由相机参数估算（包围球投影）
+    static LodInput from_camera(const aino_math::Vec3& camera_pos, const aino_math::Vec3& actor_pos,
+                                float bounding_radius, float fov_y, float importance = 1.0f) {
+        aino_math::Vec3 d = actor_pos - camera_pos;
+        float dist = std::sqrt(aino_math::dot(d, d));
+        float half_extent = std::max(dist, 1e-3f) * std::tan(fov_y * 0.5f);
+        float ratio = bounding_radius / half_extent;
+        return {dist, std::clamp(ratio * ratio, 0.0f, 1.0f), importance};
+    }
+};
+
+// 距离/屏幕占比 → LOD档位
+class LodPolicy {
+public:
+    static constexpr int LEVEL_COUNT = 4;
+    
+    std::array<LodLevel, LEVEL_COUNT> levels = {{
+        // LOD0：近景主角
+        {MuscleModel::Huxley,    0,  1.0f,  1, true,  true,  true,  true},
+        // LOD1：中景
+        {MuscleModel::Huxley,    32, 0.25f, 1, true,  true,  false, true},
+        // LOD2：远景人群
+        {MuscleModel::Moment,    10, 1.0f,  2, true,  false, false, true},
+        // LOD3：极远 / 背景
+        {MuscleModel::Baked,     10, 1.0f,  4, false, false, false, false}
+    }};
+    
+    std::array<float, LEVEL_COUNT - 1> distance_thresholds = {5.0f, 15.0f, 40.0f}; // [m]
+    float full_detail_coverage = 0.1f;  // 屏幕占比超过即强制LOD0
+    float hysteresis = 0.1f;            // 防止阈值附近来回切换
+    
+    [[nodiscard]] int select(const LodInput& in, int current = -1) const {
+        if(in.screen_coverage >= full_detail_coverage) return 0;
+        
+        // 重要度缩短有效距离
+        float effective = in.camera_distance / std::max(in.importance, 0.1f);
+        
+        int level = 0;
+        while(level < LEVEL_COUNT - 1) {
+            float threshold = distance_thresholds[level];
+            // 滞后：当前档位附近的阈值向外推移
+            if(current > level) threshold *= (1.0f - hysteresis);
+            else if(current >= 0 && current <= level) threshold *= (1.0f + hysteresis);
+            if(effective < threshold) break;
+            ++level;
+        }
+        return level;
+    }
+    
+    [[nodiscard]] const LodLevel& level(int index) const {
+        return levels[std::clamp(index, 0, LEVEL_COUNT - 1)];
+    }
+};
+
+// 烘焙姿态片段（每帧每关节Z轴角度，循环回放）
+struct BakedClip {
+    std::vector<std::vector<float>> frames;
+    float frame_rate = 30.0f;
+    
+    [[nodiscard]] bool empty() const { return frames.empty(); }
+    
+    [[nodiscard]] const std::vector<float>& sample(double time) const {
+        size_t index = (size_t)(time * frame_rate) % frames.size();
+        return frames[index];
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -6,10 +6,17 @@
 #include <array>
 #include <algorithm>
 #include <cmath>
+#include "../profiler.hpp"
 
 namespace aino_pro {
 namespace biology {
 
+// 工具函数
+inline float smoothstep(float x, float edge0, float edge1) {
+    x = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return x * x * (3.0f - 2.0f * x);
+}
+
 // 三室模型：ATP-PCr-糖原
 class MetabolicSystem {
     // 浓度（归一化 0-1）
@@ -32,6 +39,7 @@ class MetabolicSystem {
     
 public:
     void update(float muscle_activation, float dt) {
+        AINO_ZONE("metabolism.update");
         time_since_exercise += dt;
         
         // 1. ATP瞬时消耗
@@ -97,13 +105,23 @@ public:
     [[nodiscard]] std::vector<float> get_state() const {
         return {ATP, PCr, glycogen, lactate, get_perceived_exertion()};
     }
+    
+    // 可积分状态（存档 / 并行时间积分用）
+    static constexpr size_t STATE_SIZE = 6;
+    
+    [[nodiscard]] std::array<float, STATE_SIZE> save_state() const {
+        return {ATP, PCr, glycogen, lactate, pyruvate, time_since_exercise};
+    }
+    
+    void restore_state(const std::array<float, STATE_SIZE>& s) {
+        ATP = std::clamp(s[0], 0.0f, 1.0f);
+        PCr = std::clamp(s[1], 0.3f, 1.0f);
+        glycogen = std::clamp(s[2], 0.0f, 1.0f);
+        lactate = std::clamp(s[3], 0.0f, 1.0f);
+        pyruvate = std::clamp(s[4], 0.0f, 0.2f);
+        time_since_exercise = std::max(s[5], 0.0f);
+    }
 };
 
-// 工具函数
-inline float smoothstep(float x, float edge0, float edge1) {
-    x = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
-    return x * x * (3.0f - 2.0f * x);
-}
-
 } // namespace biology
 } // namespace aino_pro
@@ -0,0 +1,402 @@
+// =====================================================
+// aino_pro/systems/metrics.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <array>
+#include <map>
+#include <chrono>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <ostream>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "lod_policy.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 流水线阶段（分阶段计时 / 计数器槽位 / 指标）
+enum class PipelineStage : uint8_t {
+    Input,          // 收件箱排空 + LOD降频
+    Emotion,        // 认知评估 + 心境
+    Neural,         // 脊髓反射 + 情绪姿态偏置
+    Muscle,         // 肌肉动力学（或代理推理 / 烘焙回放）
+    Tendon,
+    Metabolism,
+    Skeleton,
+    Output,
+    Record,
+    COUNT
+};
+
+inline const char* stage_name(PipelineStage stage) {
+    static const char* NAMES[] = {"input", "emotion", "neural", "muscle", "tendon",
+                                  "metabolism", "skeleton", "output", "record"};
+    return stage < PipelineStage::COUNT ? NAMES[size_t(stage)] : "unknown";
+}
+
+static constexpr size_t STAGE_COUNT = size_t(PipelineStage::COUNT);
+static constexpr size_t LOD_TIER_COUNT = size_t(LodPolicy::LEVEL_COUNT);
+
+inline int highest_bit(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse64(&i, v);
+    return int(i);
+#else
+    return 63 - __builtin_clzll(v);
+#endif
+}
+
+class Counter {
+    std::atomic<uint64_t> v{0};
+    
+public:
+    void add(uint64_t n = 1) { v.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t value() const { return v.load(std::memory_order_relaxed); }
+    void reset() { v.store(0, std::memory_order_relaxed); }
+};
+
+class Gauge {
+    std::atomic<double> v{0.0};
+    
+public:
+    void set(double x) { v.store(x, std::memory_order_relaxed); }
+    [[nodiscard]] double value() const { return v.load(std::memory_order_relaxed); }
+    void reset() { set(0.0); }
+};
+
+struct HistogramSnapshot;
+
+// HDR式延迟直方图：2的幂分段 × 16线性子桶（相对误差 ≤ 1/16），纳秒，1ns ~ 2^40ns
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr uint64_t SUB_COUNT = 1ull << SUB_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr size_t BUCKETS = size_t(MAX_EXPONENT - SUB_BITS + 2) * SUB_COUNT;
+    
+    static size_t bucket_of(uint64_t ns) {
+        if(ns < SUB_COUNT) return size_t(ns);
+        int e = highest_bit(ns);
+        if(e > MAX_EXPONENT) return BUCKETS - 1;
+        uint64_t sub = (ns >> (e - SUB_BITS)) & (SUB_COUNT - 1);
+        return size_t(e - SUB_BITS + 1) * SUB_COUNT + size_t(sub);
+    }
+    
+    // 桶中点 [ns]
+    static double bucket_value(size_t b) {
+        if(b < SUB_COUNT) return double(b);
+        int e = int(b / SUB_COUNT) + SUB_BITS - 1;
+        double width = std::ldexp(1.0, e - SUB_BITS);
+        return std::ldexp(1.0, e) + double(b % SUB_COUNT) * width + 0.5 * width;
+    }
+    
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts{};
+    std::atomic<uint64_t> count{0}, sum_ns{0};
+    std::atomic<uint64_t> min_ns{~0ull}, max_ns{0};
+    
+public:
+    // 任意线程并发记录（relaxed 原子，不加锁）
+    void record(uint64_t ns) {
+        counts[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t lo = min_ns.load(std::memory_order_relaxed);
+        while(ns < lo && !min_ns.compare_exchange_weak(lo, ns, std::memory_order_relaxed)) {}
+        uint64_t hi = max_ns.load(std::memory_order_relaxed);
+        while(ns > hi && !max_ns.compare_exchange_weak(hi, ns, std::memory_order_relaxed)) {}
+    }
+    
+    void record_ms(float ms) { record(uint64_t(std::max(ms, 0.0f) * 1e6f)); }
+    
+    [[nodiscard]] HistogramSnapshot snapshot() const;
+    
+    void reset() {
+        for(auto& c : counts) c.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        sum_ns.store(0, std::memory_order_relaxed);
+        min_ns.store(~0ull, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+};
+
+// 快照：并发写入时各桶可能相差几次记录，总数以桶求和为准
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    double mean_ns = 0.0, min_ns = 0.0, max_ns = 0.0;
+    std::vector<uint64_t> buckets;
+    
+    [[nodiscard]] double percentile_ns(double q) const {
+        if(!count) return 0.0;
+        uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(q * count), 1), seen = 0;
+        for(size_t b = 0; b < buckets.size(); ++b) {
+            seen += buckets[b];
+            if(seen >= rank) return std::clamp(LatencyHistogram::bucket_value(b), min_ns, max_ns);
+        }
+        return max_ns;
+    }
+    
+    void write_json(std::ostream& os) const {
+        os << "{\"count\": " << count << ", \"mean_ms\": " << mean_ns * 1e-6
+           << ", \"min_ms\": " << min_ns * 1e-6 << ", \"p50_ms\": " << percentile_ns(0.5) * 1e-6
+           << ", \"p99_ms\": " << percentile_ns(0.99) * 1e-6 << ", \"p999_ms\": " << percentile_ns(0.999) * 1e-6
+           << ", \"p9999_ms\": " << percentile_ns(0.9999) * 1e-6 << ", \"max_ms\": " << max_ns * 1e-6 << "}";
+    }
+};
+
+inline HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot s;
+    s.buckets.resize(BUCKETS);
+    for(size_t b = 0; b < BUCKETS; ++b) {
+        s.buckets[b] = counts[b].load(std::memory_order_relaxed);
+        s.count += s.buckets[b];
+    }
+    if(s.count) {
+        uint64_t n = std::max<uint64_t>(count.load(std::memory_order_relaxed), 1);
+        s.mean_ns = double(sum_ns.load(std::memory_order_relaxed)) / double(n);
+        s.min_ns = double(min_ns.load(std::memory_order_relaxed));
+        s.max_ns = double(max_ns.load(std::memory_order_relaxed));
+    }
+    return s;
+}
+
+// 超预算帧记录
+struct OverrunRecord {
+    uint64_t sequence = 0;      // 日志序号（单调递增）
+    int64_t timestamp_ns = 0;   // steady_clock
+    uint64_t actor_id = 0;      // 0 = 世界帧（begin_frame → end_frame 墙钟），其余为角色ID
+    int lod_tier = 0;
+    PipelineStage stage = PipelineStage::Input; // 耗时最长的阶段
+    float frame_ms = 0.0f;
+    float stage_ms = 0.0f;
+    float budget_ms = 0.0f;
+};
+
+// 无锁环形日志：多写者（fetch_add 取槽位）+ 任意线程读（每槽序号校验，跳过写入中/已覆盖的槽）
+class OverrunLog {
+    struct Slot {
+        std::atomic<uint64_t> seq{0};   // 2i+1 = 写入中，2i+2 = 第i条已完成
+        OverrunRecord record;
+    };
+    std::unique_ptr<Slot[]> slots;
+    const uint64_t mask;
+    std::atomic<uint64_t> head{0};
+    
+public:
+    explicit OverrunLog(size_t capacity_pow2 = 1024)
+        : slots(new Slot[capacity_pow2]), mask(capacity_pow2 - 1) {}
+    
+    void push(OverrunRecord r) {
+        const uint64_t i = head.fetch_add(1, std::memory_order_relaxed);
+        Slot& s = slots[i & mask];
+        s.seq.store(2 * i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        r.sequence = i;
+        s.record = r;
+        s.seq.store(2 * i + 2, std::memory_order_release);
+    }
+    
+    // 最近至多 capacity 条（按序号升序）
+    [[nodiscard]] std::vector<OverrunRecord> snapshot(size_t max_records = ~size_t(0)) const {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        const uint64_t n = std::min<uint64_t>({h, mask + 1, max_records});
+        std::vector<OverrunRecord> out;
+        out.reserve(n);
+        for(uint64_t i = h - n; i < h; ++i) {
+            const Slot& s = slots[i & mask];
+            uint64_t before = s.seq.load(std::memory_order_acquire);
+            if(before != 2 * i + 2) continue;
+            OverrunRecord r = s.record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(s.seq.load(std::memory_order_relaxed) != before) continue;
+            out.push_back(r);
+        }
+        return out;
+    }
+    
+    [[nodiscard]] uint64_t total() const { return head.load(std::memory_order_relaxed); }
+};
+
+struct MetricsSnapshot {
+    std::vector<std::pair<std::string, uint64_t>> counters;
+    std::vector<std::pair<std::string, double>> gauges;
+    std::vector<std::pair<std::string, HistogramSnapshot>> histograms;
+    std::array<std::array<HistogramSnapshot, STAGE_COUNT>, LOD_TIER_COUNT> stage_latency;
+    std::array<HistogramSnapshot, LOD_TIER_COUNT> frame_latency;
+    std::array<uint64_t, LOD_TIER_COUNT> actor_frames{}, overruns{};
+    HistogramSnapshot world_latency;
+    uint64_t world_frames = 0, world_overruns = 0;
+    std::vector<OverrunRecord> recent_overruns;
+    
+    void write_json(std::ostream& os) const {
+        os << "{\"counters\": {";
+        for(size_t i = 0; i < counters.size(); ++i) {
+            os << (i ? ", " : "") << "\"" << counters[i].first << "\": " << counters[i].second;
+        }
+        os << "}, \"gauges\": {";
+        for(size_t i = 0; i < gauges.size(); ++i) {
+            os << (i ? ", " : "") << "\"" << gauges[i].first << "\": " << gauges[i].second;
+        }
+        os << "}, \"histograms\": {";
+        for(size_t i = 0; i < histograms.size(); ++i) {
+            os << (i ? ", " : "") << "\"" << histograms[i].first << "\": ";
+            histograms[i].second.write_json(os);
+        }
+        os << "}, \"lod_tiers\": [";
+        bool first = true;
+        for(size_t t = 0; t < LOD_TIER_COUNT; ++t) {
+            if(!actor_frames[t]) continue;
+            os << (first ? "" : ", ") << "{\"tier\": " << t << ", \"actor_frames\": " << actor_frames[t]
+               << ", \"overruns\": " << overruns[t] << ", \"frame\": ";
+            first = false;
+            frame_latency[t].write_json(os);
+            os << ", \"stages\": {";
+            for(size_t s = 0; s < STAGE_COUNT; ++s) {
+                os << (s ? ", " : "") << "\"" << stage_name(PipelineStage(s)) << "\": ";
+                stage_latency[t][s].write_json(os);
+            }
+            os << "}}";
+        }
+        os << "], \"world\": {\"frames\": " << world_frames << ", \"overruns\": " << world_overruns << ", \"frame\": ";
+        world_latency.write_json(os);
+        os << "}, \"recent_overruns\": [";
+        for(size_t i = 0; i < recent_overruns.size(); ++i) {
+            const auto& r = recent_overruns[i];
+            os << (i ? ", " : "") << "{\"sequence\": " << r.sequence << ", \"actor\": " << r.actor_id
+               << ", \"lod_tier\": " << r.lod_tier << ", \"stage\": \"" << (r.actor_id ? stage_name(r.stage) : "world")
+               << "\", \"frame_ms\": " << r.frame_ms << ", \"stage_ms\": " << r.stage_ms
+               << ", \"budget_ms\": " << r.budget_ms << "}";
+        }
+        os << "]}";
+    }
+};
+
+// 引擎级指标注册表：
+//   固定指标（每LOD档位 × 每阶段延迟、每档位帧延迟/帧数/超预算数）热路径无查找
+//   命名指标（计数器 / 仪表 / 直方图）注册时加锁，返回的引用在注册表存活期内有效
+// 默认关闭；快照可在任意线程读取，不暂停模拟
+class MetricsRegistry {
+    std::atomic<bool> enabled{false};
+    
+    std::array<std::array<LatencyHistogram, STAGE_COUNT>, LOD_TIER_COUNT> stage_latency;
+    std::array<LatencyHistogram, LOD_TIER_COUNT> frame_latency;
+    std::array<Counter, LOD_TIER_COUNT> actor_frames, overruns;
+    LatencyHistogram world_latency;
+    Counter world_frames, world_overruns;
+    OverrunLog overrun_log;
+    
+    mutable std::mutex mutex;
+    std::map<std::string, std::unique_ptr<Counter>> counters;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges;
+    std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms;
+    
+public:
+    void set_enabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    [[nodiscard]] bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    
+    Counter& counter(const std::string& name) { return find_or_add(counters, name); }
+    Gauge& gauge(const std::string& name) { return find_or_add(gauges, name); }
+    LatencyHistogram& histogram(const std::string& name) { return find_or_add(histograms, name); }
+    
+    // 世界帧末调用（模拟线程，每帧一次）：整帧墙钟时间对照整帧预算
+    void record_world_frame(float frame_ms, float budget_ms) {
+        world_latency.record_ms(frame_ms);
+        world_frames.add();
+        if(frame_ms <= budget_ms) return;
+        world_overruns.add();
+        OverrunRecord r;
+        r.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        r.frame_ms = frame_ms;
+        r.budget_ms = budget_ms;
+        overrun_log.push(r);
+    }
+    
+    // 角色帧末调用（可并发）：stage_ms 长度 STAGE_COUNT；budget_ms 为本角色的预算份额（归因用）
+    void record_actor_frame(uint64_t actor_id, int lod_tier, const float* stage_ms,
+                            float frame_ms, float budget_ms) {
+        const size_t tier = (size_t)std::clamp(lod_tier, 0, int(LOD_TIER_COUNT) - 1);
+        size_t worst = 0;
+        for(size_t s = 0; s < STAGE_COUNT; ++s) {
+            stage_latency[tier][s].record_ms(stage_ms[s]);
+            if(stage_ms[s] > stage_ms[worst]) worst = s;
+        }
+        frame_latency[tier].record_ms(frame_ms);
+        actor_frames[tier].add();
+        
+        if(frame_ms > budget_ms) {
+            overruns[tier].add();
+            OverrunRecord r;
+            r.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            r.actor_id = actor_id;
+            r.lod_tier = int(tier);
+            r.stage = PipelineStage(worst);
+            r.frame_ms = frame_ms;
+            r.stage_ms = stage_ms[worst];
+            r.budget_ms = budget_ms;
+            overrun_log.push(r);
+        }
+    }
+    
+    [[nodiscard]] const OverrunLog& get_overrun_log() const { return overrun_log; }
+    
+    [[nodiscard]] MetricsSnapshot snapshot(size_t max_overruns = 64) const {
+        MetricsSnapshot s;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(const auto& [name, c] : counters) s.counters.emplace_back(name, c->value());
+            for(const auto& [name, g] : gauges) s.gauges.emplace_back(name, g->value());
+            for(const auto& [name, h] : histograms) s.histograms.emplace_back(name, h->snapshot());
+        }
+        for(size_t t = 0; t < LOD_TIER_COUNT; ++t) {
+            s.actor_frames[t] = actor_frames[t].value();
+            s.overruns[t] = overruns[t].value();
+            if(!s.actor_frames[t]) continue;
+            s.frame_latency[t] = frame_latency[t].snapshot();
+            for(size_t st = 0; st < STAGE_COUNT; ++st) s.stage_latency[t][st] = stage_latency[t][st].snapshot();
+        }
+        s.world_frames = world_frames.value();
+        s.world_overruns = world_overruns.value();
+        s.world_latency = world_latency.snapshot();
+        s.recent_overruns = overrun_log.snapshot(max_overruns);
+        return s;
+    }
+    
+    // 清零全部指标（超预算日志保留）
+    void reset() {
+        for(auto& tier : stage_latency) for(auto& h : tier) h.reset();
+        for(auto& h : frame_latency) h.reset();
+        for(auto& c : actor_frames) c.reset();
+        for(auto& c : overruns) c.reset();
+        world_latency.reset();
+        world_frames.reset();
+        world_overruns.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& [name, c] : counters) c->reset();
+        for(auto& [name, g] : gauges) g->reset();
+        for(auto& [name, h] : histograms) h->reset();
+    }
+    
+private:
+    template<typename T>
+    T& find_or_add(std::map<std::string, std::unique_ptr<T>>& table, const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& slot = table[name];
+        if(!slot) slot = std::make_unique<T>();
+        return *slot;
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -7,6 +7,8 @@
 #include <optional>
 #include <algorithm>
 #include "../aino_math.hpp"
+#include "../aino_animation.hpp"
+#include "../profiler.hpp"
 
 namespace aino_pro {
 namespace biology {
@@ -39,6 +41,8 @@ class BallJoint {
         aino_math::Vec3 limit_max = { 2.8f,  1.5f,  0.8f};
     } capsule;
     
+    friend class ArticulatedSkeleton; // 预设关节参数
+    
 public:
     void compute_torque(const aino_math::Vec3& muscle_torque, 
                        const aino_math::Vec3& external_force, 
@@ -94,6 +98,9 @@ public:
         }
     }
     
+    // 外部直接驱动（代理模型 / 回放）
+    void set_angle(const aino_math::Vec3& a) { angle = a; velocity = {0, 0, 0}; }
+    
     [[nodiscard]] const aino_math::Vec3& get_angle() const { return angle; }
     [[nodiscard]] const aino_math::Vec3& get_velocity() const { return velocity; }
 };
@@ -110,12 +117,13 @@ class ArticulatedSkeleton {
     std::vector<BallJoint> joints;
     std::vector<float> inertia;
     std::vector<aino_math::Vec3> external_forces; // 每关节外力
+    std::vector<aino_math::Vec3> muscle_torques;  // 每关节肌肉力矩
     float lever_arm = 0.1f; // 默认力臂长度
     
 public:
     explicit ArticulatedSkeleton(int joint_count = JOINT_COUNT) 
         : joints(joint_count), inertia(joint_count, 1.0f), 
-          external_forces(joint_count) {
+          external_forces(joint_count), muscle_torques(joint_count) {
         // 预设人体关节参数
         joints[SPINE].capsule.stiffness = 150.0f;
         joints[SHOULDER].capsule.limit_min = {-2.0f, -1.0f, -0.5f};
@@ -132,6 +140,15 @@ public:
         }
     }
     
+    // 前向动力学：肌肉力矩 + 外力 → 关节角
+    void forward_dynamics(float dt) {
+        AINO_ZONE("skeleton.forward_dynamics");
+        for(size_t i=0; i<joints.size(); ++i) {
+            joints[i].compute_torque(muscle_torques[i], external_forces[i], lever_arm, dt);
+            joints[i].forward_dynamics(inertia[i], dt);
+        }
+    }
+    
     // 逆向动力学（从运动反算肌肉力）
     [[nodiscard]] std::vector<float> inverse_dynamics(
         const std::vector<aino_math::Vec3>& joint_angles,
@@ -141,8 +158,9 @@ public:
         std::vector<float> muscle_forces(joints.size() * 2, 0.0f);
         std::vector<aino_math::Vec3> gravity_forces(joints.size(), {0, -9.81f, 0});
         
+        const size_t count = std::min(joints.size(), joint_angles.size());
         #pragma omp parallel for
-        for(size_t i=0; i<joints.size() && i<joint_angles.size(); ++i) {
+        for(size_t i=0; i<count; ++i) {
             // 重力矩
             aino_math::Vec3 torque_gravity = cross(gravity_forces[i] * 10.0f, {lever_arm, 0, 0});
             
@@ -168,6 +186,22 @@ public:
         }
     }
     
+    void set_muscle_torque(size_t joint_index, const aino_math::Vec3& torque) {
+        if(joint_index < muscle_torques.size()) {
+            muscle_torques[joint_index] = torque;
+        }
+    }
+    
+    void set_joint_rotation_z(size_t joint_index, float z) {
+        if(joint_index < joints.size()) {
+            auto a = joints[joint_index].get_angle();
+            a.z = z;
+            joints[joint_index].set_angle(a);
+        }
+    }
+    
+    [[nodiscard]] size_t joint_count() const { return joints.size(); }
+    
     [[nodiscard]] std::vector<aino_math::Vec3> get_joint_angles() const {
         std::vector<aino_math::Vec3> angles(joints.size());
         for(size_t i=0; i<joints.size(); ++i) {
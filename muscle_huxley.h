@@ -7,18 +7,26 @@
 #include <array>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <type_traits>
+#include "../profiler.hpp"
 
 namespace aino_pro {
 namespace biology {
 
 // 单肌肉纤维（Huxley 1957微缩实现）
 class HuxleyFiber {
-    // 运行时可配置的网格大小
-    static int GRID_SIZE;
+public:
+    static constexpr int DEFAULT_GRID_SIZE = 100;
+    // 编译期特化的网格大小（其余走通用回退）
+    static constexpr std::array<int, 6> SPECIALIZED_GRID_SIZES = {10, 32, 64, 100, 128, 200};
+    
+private:
     static constexpr float DX = 1.0f; // nm
     static constexpr float LAMBDA = 10.0f; // 特征长度 nm
+    static constexpr int UNROLL_LIMIT = 32; // 小网格完全展开
     
-    // 状态分布（对齐到64字节缓存行）
+    // 状态分布（网格大小 = n.size()，每纤维独立）
     alignas(64) std::vector<float> n;
     
     struct Params {
@@ -32,24 +40,110 @@ class HuxleyFiber {
     } params;
     
     float F_ce = 0.0f; // 收缩力
+    float Q0 = 0.0f;   // 结合横桥比例（零阶矩）
     
 public:
-    HuxleyFiber() {
-        n.resize(GRID_SIZE, 0.0f);
-    }
+    explicit HuxleyFiber(int grid_size = DEFAULT_GRID_SIZE) : n(grid_size, 0.0f) {}
     
     void step(float activation, float length, float velocity, float dt) {
-        // 重新分配网格（如果全局大小改变）
-        if((int)n.size() != GRID_SIZE) {
-            n.resize(GRID_SIZE, 0.0f);
+        float v_rel = velocity / params.v_max;
+        
+        // 按网格大小分派到编译期特化内核
+        switch((int)n.size()) {
+            case 10:  step_kernel(std::integral_constant<int, 10>{}, activation, v_rel, dt); break;
+            case 32:  step_kernel(std::integral_constant<int, 32>{}, activation, v_rel, dt); break;
+            case 64:  step_kernel(std::integral_constant<int, 64>{}, activation, v_rel, dt); break;
+            case 100: step_kernel(std::integral_constant<int, 100>{}, activation, v_rel, dt); break;
+            case 128: step_kernel(std::integral_constant<int, 128>{}, activation, v_rel, dt); break;
+            case 200: step_kernel(std::integral_constant<int, 200>{}, activation, v_rel, dt); break;
+            default:  step_kernel((int)n.size(), activation, v_rel, dt); break;
         }
         
-        float v_rel = velocity / params.v_max;
+        // Hill项修正
+        if(velocity > 0.0f) {
+            F_ce += params.a * velocity / (params.b + velocity);
+        }
+    }
+    
+    // 改变网格分辨率：按当前结合比例重建分布
+    void set_grid_size(int grid_size, float activation) {
+        if(grid_size == (int)n.size() || grid_size <= 0) return;
+        n.assign(grid_size, 0.0f);
+        project_from_moment(Q0, activation);
+    }
+    
+    [[nodiscard]] int get_grid_size() const { return (int)n.size(); }
+    [[nodiscard]] float get_force() const { return F_ce; }
+    [[nodiscard]] float get_activation() const { return n[n.size()/2]; }
+    [[nodiscard]] float get_bound_fraction() const { return Q0; }
+    
+    // 矩模型 → 网格：按稳态分布形状重建 n(x)，使结合比例等于 q
+    void project_from_moment(float q, float activation) {
+        const int grid = (int)n.size();
+        
+        float sum = 0.0f;
+        for(int i = 0; i < grid; ++i) {
+            float x = (i - grid/2) * DX;
+            float f = params.f1 * std::exp(-std::abs(x) / LAMBDA) * std::max(activation, 1e-3f);
+            float g = params.g1 + params.g2 * std::max(x / LAMBDA, 0.0f);
+            n[i] = f / (f + g);
+            sum += n[i];
+        }
+        float scale = sum > 0.0f ? q * grid / sum : 0.0f;
+        for(auto& v : n) v = std::clamp(v * scale, 0.0f, 1.0f);
+        Q0 = q;
+    }
+    
+    // 粗分箱（矩模型用）：正/负 x 各 bins_per_side 组，按 |x| 等宽划分
+    [[nodiscard]] int cell_bin(int i, int bins_per_side) const {
+        const int grid = (int)n.size();
+        const int x = i - grid/2;
+        const int b = std::min(std::abs(x) * bins_per_side / std::max(grid/2, 1), bins_per_side - 1);
+        return (x > 0 ? bins_per_side : 0) + b;
+    }
+    
+    // 各组速率和（f 不含激活）、力权重和、格点数；数组长度 2 * bins_per_side
+    void bin_rates(int bins_per_side, float* f_sum, float* g_sum, float* weight, float* cells) const {
+        for(int i = 0; i < (int)n.size(); ++i) {
+            const int b = cell_bin(i, bins_per_side);
+            float x = (i - (int)n.size()/2) * DX;
+            f_sum[b] += params.f1 * std::exp(-std::abs(x) / LAMBDA);
+            g_sum[b] += params.g1 + params.g2 * std::max(x / LAMBDA, 0.0f);
+            weight[b] += params.k * (x * 1e-9f);
+            cells[b] += 1.0f;
+        }
+    }
+    
+    // 各组结合比例之和累加到 out
+    void accumulate_bins(int bins_per_side, float* out) const {
+        for(int i = 0; i < (int)n.size(); ++i) out[cell_bin(i, bins_per_side)] += n[i];
+    }
+    
+    // 分箱 → 网格：组内格点取组均值
+    void set_from_bins(int bins_per_side, const float* mean) {
+        const int grid = (int)n.size();
+        float sum_force = 0.0f, sum_bound = 0.0f;
+        for(int i = 0; i < grid; ++i) {
+            n[i] = std::clamp(mean[cell_bin(i, bins_per_side)], 0.0f, 1.0f);
+            sum_force += n[i] * params.k * ((i - grid/2) * DX * 1e-9f);
+            sum_bound += n[i];
+        }
+        F_ce = sum_force;
+        Q0 = sum_bound / grid;
+    }
+    
+private:
+    // 网格内核：Size 为 std::integral_constant（编译期常量）或 int（通用回退）
+    template<typename Size>
+    void step_kernel(Size size, float activation, float v_rel, float dt) {
+        const int N = size;
+        float* state = n.data();
         float sum_force = 0.0f;
+        float sum_bound = 0.0f;
         
-        // 遍历横桥位置
-        for(int i = 0; i < GRID_SIZE; ++i) {
-            float x = (i - GRID_SIZE/2) * DX;
+        // 单个横桥位置
+        auto cell = [&](int i) {
+            float x = (i - N/2) * DX;
             
             // 速率函数
             float f = params.f1 * std::exp(-std::abs(x) / LAMBDA) * activation;
@@ -57,33 +151,38 @@ public:
             
             // 对流项（带边界处理）
             int i_left = std::max(i - 1, 0);
-            int i_right = std::min(i + 1, GRID_SIZE - 1);
-            float convection = v_rel * (n[i_right] - n[i_left]) / (2.0f * DX);
+            int i_right = std::min(i + 1, N - 1);
+            float convection = v_rel * (state[i_right] - state[i_left]) / (2.0f * DX);
             
             // 动力学更新（显性欧拉）
-            float dn_dt = f * (1.0f - n[i]) - g * n[i] - convection;
-            n[i] += dn_dt * dt;
-            n[i] = std::clamp(n[i], 0.0f, 1.0f);
+            float dn_dt = f * (1.0f - state[i]) - g * state[i] - convection;
+            state[i] = std::clamp(state[i] + dn_dt * dt, 0.0f, 1.0f);
             
             // 累加力
-            sum_force += n[i] * params.k * (x * 1e-9f); // 转米
+            sum_force += state[i] * params.k * (x * 1e-9f); // 转米
+            sum_bound += state[i];
+        };
+        
+        if constexpr(!std::is_same_v<Size, int>) {
+            if constexpr(Size::value <= UNROLL_LIMIT) {
+                unroll(cell, std::make_integer_sequence<int, Size::value>{});
+            } else {
+                for(int i = 0; i < Size::value; ++i) cell(i);
+            }
+        } else {
+            for(int i = 0; i < N; ++i) cell(i);
         }
         
         F_ce = sum_force;
-        
-        // Hill项修正
-        if(velocity > 0.0f) {
-            F_ce += params.a * velocity / (params.b + velocity);
-        }
+        Q0 = sum_bound / N;
     }
     
-    [[nodiscard]] float get_force() const { return F_ce; }
-    [[nodiscard]] float get_activation() const { return n[GRID_SIZE/2]; }
+    template<typename F, int... I>
+    static void unroll(F& f, std::integer_sequence<int, I...>) {
+        (f(I), ...);
+    }
 };
 
-// 全局网格大小定义
-int HuxleyFiber::GRID_SIZE = 100;
-
 // 整块肌肉（多纤维聚合）
 class Muscle {
     std::vector<HuxleyFiber> fibers;
@@ -92,29 +191,215 @@ class Muscle {
     float length = 0.3f; // 肌肉长度 [m]
     float velocity = 0.0f; // 收缩速度 [m/s]
     float output_force = 0.0f;
+    float max_force = 0.0f;   // 满激活稳态（分箱模型解析值），关节扭矩归一化用
+    
+    // 廉价估计：粗分箱Huxley（组内格点共享平均速率，与网格同一显式格式推进）
+    // 组数与网格分辨率无关；力权重在构造 / 改网格时由纤维参数直接求得，无需精算标定
+    static constexpr int MOMENT_BINS = 8;           // 每侧（x ≤ 0 / x > 0）组数
+    struct MomentBin {
+        float n = 0.0f;         // 组内平均结合比例
+        float f = 0.0f, g = 0.0f;
+        float force = 0.0f;     // 组力权重（含质量 / 羽状角）
+        float share = 0.0f;     // 组格点数 / 网格大小
+    };
+    struct MomentState {
+        std::array<MomentBin, 2 * MOMENT_BINS> bins{};
+        float bound_fraction = 0.0f;
+    } moment;
+    
+    // 估计期间的激活序列：精算按原步长重放（窗口满时以当时的估计状态为起点）
+    struct PendingStep {
+        float activation, dt;
+    };
+    std::vector<PendingStep> history;
+    std::array<float, 2 * MOMENT_BINS> anchor{};
+    bool anchored = false;
+    
+    float pending_dt = 0.0f;        // 仅估计、未精算的累积时间
+    float last_activation = 0.0f;
+    bool refined = true;
+    bool visible = true;
+    size_t active_fibers = 0;       // LOD：参与计算的纤维数（0 = 全部）
+    int grid_size = HuxleyFiber::DEFAULT_GRID_SIZE;
+    
+    static constexpr float MAX_CATCHUP_DT = 0.1f;  // 追赶窗口（限制单次精算开销）
+    static constexpr size_t MAX_HISTORY = 16;
+    static constexpr float MAX_SUBSTEP = 0.02f;    // 显式欧拉稳定步长
     
 public:
-    explicit Muscle(int fiber_count = 100) : fibers(fiber_count) {}
+    explicit Muscle(int fiber_count = 100, int grid = HuxleyFiber::DEFAULT_GRID_SIZE)
+        : fibers(fiber_count, HuxleyFiber(grid)), grid_size(grid) {
+        history.reserve(MAX_HISTORY);
+        build_moment_model();
+    }
     
+    // 完整Huxley步进（先补齐未精算的估计时间）
     void step(float activation, float dt) {
+        if(!history.empty() || anchored) refine();
+        step_fibers(activation, dt);
+        sync_moment_model();
+        last_activation = activation;
+        refined = true;
+    }
+    
+    // 阶段1：廉价估计，推进分箱模型并记录待精算的激活序列
+    void estimate(float activation, float dt) {
+        if(!history.empty() && (pending_dt + dt > MAX_CATCHUP_DT || history.size() >= MAX_HISTORY)) {
+            for(size_t k = 0; k < moment.bins.size(); ++k) anchor[k] = moment.bins[k].n;
+            anchored = true;
+            history.clear();
+            pending_dt = 0.0f;
+        }
+        history.push_back({activation, dt});
+        
+        const int substeps = std::max(1, (int)std::ceil(dt / MAX_SUBSTEP));
+        const float h = dt / substeps;
+        float force = 0.0f, q = 0.0f;
+        for(auto& bin : moment.bins) {
+            const float f = bin.f * activation;
+            for(int s = 0; s < substeps; ++s) {
+                bin.n = std::clamp(bin.n + (f * (1.0f - bin.n) - bin.g * bin.n) * h, 0.0f, 1.0f);
+            }
+            force += bin.force * bin.n;
+            q += bin.share * bin.n;
+        }
+        moment.bound_fraction = q;
+        output_force = force;
+        
+        pending_dt += dt;
+        last_activation = activation;
+        refined = false;
+    }
+    
+    // 阶段2：Huxley网格按记录的激活序列追赶估计期间的时间，替换估计值
+    void refine() {
+        if(anchored) {
+            for(size_t i = 0, count = fiber_count(); i < count; ++i) fibers[i].set_from_bins(MOMENT_BINS, anchor.data());
+            anchored = false;
+        }
+        for(const auto& pending : history) {
+            int substeps = std::max(1, (int)std::ceil(pending.dt / MAX_SUBSTEP));
+            for(int s = 0; s < substeps; ++s) {
+                step_fibers(pending.activation, pending.dt / substeps);
+            }
+        }
+        history.clear();
+        sync_moment_model();
+        pending_dt = 0.0f;
+        refined = true;
+    }
+    
+    // LOD：只计算前 fraction 比例的纤维（其余保持状态）
+    void set_fiber_fraction(float fraction) {
+        size_t count = (size_t)std::ceil(fibers.size() * std::clamp(fraction, 0.0f, 1.0f));
+        active_fibers = std::clamp<size_t>(count, 1, fibers.size());
+    }
+    
+    // 模型切换：分箱估计状态 → Huxley网格（含未参与计算的纤维）
+    void project_moment_to_fibers() {
+        std::array<float, 2 * MOMENT_BINS> mean;
+        for(size_t k = 0; k < mean.size(); ++k) mean[k] = moment.bins[k].n;
+        for(auto& f : fibers) f.set_from_bins(MOMENT_BINS, mean.data());
+        history.clear();
+        anchored = false;
+        pending_dt = 0.0f;
+    }
+    
+    // 慢变量：结合比例（设置时按比例缩放各组并同步重建纤维网格）
+    [[nodiscard]] float get_bound_fraction() const { return moment.bound_fraction; }
+    
+    void set_bound_fraction(float q) {
+        q = std::clamp(q, 0.0f, 1.0f);
+        const float current = moment.bound_fraction;
+        float force = 0.0f, bound = 0.0f;
+        for(auto& bin : moment.bins) {
+            bin.n = std::clamp(current > 1e-6f ? bin.n * q / current : q, 0.0f, 1.0f);
+            force += bin.force * bin.n;
+            bound += bin.share * bin.n;
+        }
+        moment.bound_fraction = bound;
+        output_force = force;
+        project_moment_to_fibers();
+    }
+    
+    [[nodiscard]] bool is_refined() const { return refined; }
+    [[nodiscard]] float get_last_activation() const { return last_activation; }
+    [[nodiscard]] float get_mass() const { return mass; }
+    [[nodiscard]] bool is_visible() const { return visible; }
+    void set_visible(bool v) { visible = v; }
+    
+    // 每肌肉网格分辨率（LOD / 精度切换）：先落实估计状态，再按新网格重建分箱
+    void set_grid_size(int grid) {
+        if(grid == grid_size || grid <= 0) return;
+        if(!refined) project_moment_to_fibers();
+        for(auto& f : fibers) f.set_grid_size(grid, last_activation);
+        grid_size = grid;
+        build_moment_model();
+    }
+    
+    [[nodiscard]] int get_grid_size() const { return grid_size; }
+    
+    [[nodiscard]] float get_force() const { return output_force; }
+    [[nodiscard]] float get_max_force() const { return max_force; }
+    
+private:
+    void step_fibers(float activation, float dt) {
+        AINO_ZONE("muscle.huxley");
+        const size_t count = fiber_count();
+        
         // 并行更新所有纤维
         #pragma omp parallel for
-        for(size_t i = 0; i < fibers.size(); ++i) {
+        for(size_t i = 0; i < count; ++i) {
             fibers[i].step(activation, length, velocity, dt);
         }
         
         // 聚合力输出（考虑羽状角）
         float sum = 0.0f;
-        for(const auto& f : fibers) sum += f.get_force();
-        output_force = (sum / fibers.size()) * mass * std::cos(pennation_angle);
+        for(size_t i = 0; i < count; ++i) sum += fibers[i].get_force();
+        output_force = (sum / count) * mass * std::cos(pennation_angle);
     }
     
-    static void set_global_grid_size(int size) {
-        HuxleyFiber::GRID_SIZE = size;
+    [[nodiscard]] size_t fiber_count() const {
+        return active_fibers ? std::min(active_fibers, fibers.size()) : fibers.size();
     }
     
-    [[nodiscard]] float get_force() const { return output_force; }
+    // 由纤维参数求各组平均速率与力权重，再从当前网格同步组状态
+    void build_moment_model() {
+        if(fibers.empty()) return;
+        std::array<float, 2 * MOMENT_BINS> f{}, g{}, weight{}, cells{};
+        fibers.front().bin_rates(MOMENT_BINS, f.data(), g.data(), weight.data(), cells.data());
+        const float scale = mass * std::cos(pennation_angle);
+        max_force = 0.0f;
+        for(size_t k = 0; k < moment.bins.size(); ++k) {
+            auto& bin = moment.bins[k];
+            bin.f = cells[k] > 0.0f ? f[k] / cells[k] : 0.0f;
+            bin.g = cells[k] > 0.0f ? g[k] / cells[k] : 0.0f;
+            bin.force = weight[k] * scale;
+            bin.share = cells[k] / (float)grid_size;
+            if(bin.f + bin.g > 0.0f) max_force += bin.force * bin.f / (bin.f + bin.g);   // 稳态 n = f / (f + g)
+        }
+        max_force = std::max(std::abs(max_force), 1e-20f);
+        sync_moment_model();
+    }
+    
+    // 精算结果 → 分箱模型（组内平均）
+    void sync_moment_model() {
+        if(fibers.empty()) return;
+        const size_t count = fiber_count();
+        std::array<float, 2 * MOMENT_BINS> sum{};
+        for(size_t i = 0; i < count; ++i) fibers[i].accumulate_bins(MOMENT_BINS, sum.data());
+        
+        float q = 0.0f;
+        for(size_t k = 0; k < moment.bins.size(); ++k) {
+            auto& bin = moment.bins[k];
+            const float cells = bin.share * grid_size * count;
+            bin.n = cells > 0.0f ? sum[k] / cells : 0.0f;
+            q += bin.share * bin.n;
+        }
+        moment.bound_fraction = q;
+    }
     
+public:
     // 肌肉附着点（简化）
     struct Attachment {
         std::string bone_name;
@@ -122,14 +407,5 @@ public:
     } origin, insertion;
 };
 
-// 肌肉系统全局管理
-class MuscleSystem {
-public:
-    static void reconfigure_all() {
-        // 触发所有肌肉实例重配置
-        // 实际实现需要对象注册表，这里简化
-    }
-};
-
 } // namespace biology
 } // namespace aino_pro
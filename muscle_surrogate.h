@@ -0,0 +1,460 @@
+// =====================================================
+// aino_pro/learning/muscle_surrogate.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <array>
+#include <string>
+#include <fstream>
+#include <random>
+#include <numeric>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <immintrin.h>
+#include "../systems/data_recorder.hpp"
+#include "../psychology/cognitive_appraisal.hpp"
+#include "../profiler.hpp"
+
+namespace aino_pro {
+namespace learning {
+
+// 刺激特征（4维：威胁 / 奖励 / 丧失 / 紧迫度，取最大值）
+static constexpr size_t STIMULUS_FEATURES = 4;
+
+inline std::array<float, STIMULUS_FEATURES> stimulus_features(
+    const psychology::Stimulus* stimuli, size_t count) {
+    std::array<float, STIMULUS_FEATURES> feat = {0.0f, 0.0f, 0.0f, 0.0f};
+    for(size_t i = 0; i < count; ++i) {
+        const auto& s = stimuli[i];
+        switch(s.resolved_category()) {
+            case psychology::StimulusCategory::Threat: feat[0] = std::max(feat[0], s.intensity); break;
+            case psychology::StimulusCategory::Reward: feat[1] = std::max(feat[1], s.intensity); break;
+            case psychology::StimulusCategory::Loss:   feat[2] = std::max(feat[2], s.intensity); break;
+            default: break;
+        }
+        feat[3] = std::max(feat[3], s.urgency);
+    }
+    return feat;
+}
+
+inline std::array<float, STIMULUS_FEATURES> stimulus_features(
+    const std::vector<psychology::Stimulus>& stimuli) {
+    return stimulus_features(stimuli.data(), stimuli.size());
+}
+
+// 输入/输出布局
+// 输入 = [期望扭矩 | 刺激特征 | 上一帧激活 | 上一帧关节角]
+// 输出 = [肌肉激活 | 关节角]
+struct SurrogateLayout {
+    size_t joint_count = 23;
+    size_t activation_count = 25;
+    
+    [[nodiscard]] size_t input_size() const {
+        return joint_count + STIMULUS_FEATURES + activation_count + joint_count;
+    }
+    [[nodiscard]] size_t output_size() const { return activation_count + joint_count; }
+};
+
+namespace detail {
+
+// SIMD宽度对齐（AVX-512一次16个float）
+static constexpr size_t LANE_PAD = 16;
+inline size_t padded(size_t n) { return (n + LANE_PAD - 1) / LANE_PAD * LANE_PAD; }
+
+// 点积内核：n 必须是 LANE_PAD 的整数倍（零填充）
+inline float dot(const float* a, const float* b, size_t n) {
+#if defined(__AVX512F__)
+    __m512 acc = _mm512_setzero_ps();
+    for(size_t i = 0; i < n; i += 16) {
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc);
+    }
+    return _mm512_reduce_add_ps(acc);
+#elif defined(__AVX2__) && defined(__FMA__)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    for(size_t i = 0; i < n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    lo = _mm_hadd_ps(lo, lo);
+    lo = _mm_hadd_ps(lo, lo);
+    return _mm_cvtss_f32(lo);
+#else
+    float sum = 0.0f;
+    for(size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+#endif
+}
+
+} // namespace detail
+
+// 全连接层（行主序，输入维度按SIMD宽度零填充）
+struct DenseLayer {
+    size_t in = 0, out = 0, stride = 0;
+    std::vector<float> W;   // out × stride
+    std::vector<float> b;   // out
+    
+    DenseLayer() = default;
+    DenseLayer(size_t in_size, size_t out_size)
+        : in(in_size), out(out_size), stride(detail::padded(in_size)),
+          W(out_size * detail::padded(in_size), 0.0f), b(out_size, 0.0f) {}
+    
+    // x 长度 >= stride（尾部零填充）
+    void forward(const float* x, float* y) const {
+        for(size_t o = 0; o < out; ++o) {
+            y[o] = b[o] + detail::dot(&W[o * stride], x, stride);
+        }
+    }
+};
+
+// 小型MLP代理：(扭矩, 刺激, 上一状态) → (激活, 关节角)
+class SurrogateMLP {
+    SurrogateLayout layout;
+    std::vector<DenseLayer> layers;  // tanh隐藏层 + 线性输出层
+    
+    // 输入/输出标准化（训练时统计）
+    std::vector<float> in_mean, in_scale;
+    std::vector<float> out_mean, out_scale;
+    
+    friend class SurrogateTrainer;
+    
+public:
+    // 每线程推理缓冲（避免运行时分配）
+    struct Workspace {
+        std::vector<float> a, b;
+    };
+    
+    SurrogateMLP() = default;
+    SurrogateMLP(const SurrogateLayout& l, size_t hidden = 64, size_t hidden_layers = 2)
+        : layout(l),
+          in_mean(l.input_size(), 0.0f), in_scale(l.input_size(), 1.0f),
+          out_mean(l.output_size(), 0.0f), out_scale(l.output_size(), 1.0f) {
+        size_t prev = l.input_size();
+        for(size_t i = 0; i < hidden_layers; ++i) {
+            layers.emplace_back(prev, hidden);
+            prev = hidden;
+        }
+        layers.emplace_back(prev, l.output_size());
+        initialize_weights(42);
+    }
+    
+    // Xavier初始化
+    void initialize_weights(uint32_t seed) {
+        std::mt19937 rng(seed);
+        for(auto& layer : layers) {
+            std::normal_distribution<float> dist(0.0f, std::sqrt(2.0f / (layer.in + layer.out)));
+            for(size_t o = 0; o < layer.out; ++o) {
+                for(size_t i = 0; i < layer.in; ++i) layer.W[o * layer.stride + i] = dist(rng);
+            }
+            std::fill(layer.b.begin(), layer.b.end(), 0.0f);
+        }
+    }
+    
+    [[nodiscard]] const SurrogateLayout& get_layout() const { return layout; }
+    [[nodiscard]] bool empty() const { return layers.empty(); }
+    
+    void prepare(Workspace& ws) const {
+        size_t widest = 0;
+        for(const auto& layer : layers) widest = std::max({widest, layer.stride, layer.out});
+        widest = detail::padded(widest);
+        ws.a.assign(widest, 0.0f);
+        ws.b.assign(widest, 0.0f);
+    }
+    
+    // 前向推理：in 长度 input_size()，out 长度 output_size()
+    void forward(const float* in, float* out, Workspace& ws) const {
+        AINO_ZONE("surrogate.forward");
+        if(ws.a.empty()) prepare(ws);
+        
+        // 1. 输入标准化
+        for(size_t i = 0; i < layout.input_size(); ++i) {
+            ws.a[i] = (in[i] - in_mean[i]) * in_scale[i];
+        }
+        std::fill(ws.a.begin() + layout.input_size(),
+                  ws.a.begin() + detail::padded(layout.input_size()), 0.0f);
+        
+        // 2. 隐藏层（tanh）
+        float* x = ws.a.data();
+        float* y = ws.b.data();
+        for(size_t l = 0; l + 1 < layers.size(); ++l) {
+            layers[l].forward(x, y);
+            for(size_t o = 0; o < layers[l].out; ++o) y[o] = std::tanh(y[o]);
+            std::fill(y + layers[l].out, y + detail::padded(layers[l].out), 0.0f);
+            std::swap(x, y);
+        }
+        
+        // 3. 线性输出 + 反标准化
+        const auto& last = layers.back();
+        last.forward(x, y);
+        for(size_t o = 0; o < last.out; ++o) {
+            out[o] = y[o] / out_scale[o] + out_mean[o];
+        }
+    }
+    
+    // 二进制权重文件
+    void save(const std::string& path) const {
+        std::ofstream f(path, std::ios::binary);
+        if(!f) throw std::runtime_error("Failed to write surrogate: " + path);
+        
+        auto put_u64 = [&](uint64_t v) { f.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+        auto put_vec = [&](const std::vector<float>& v) {
+            put_u64(v.size());
+            f.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(float));
+        };
+        
+        f.write("AINOSURR", 8);
+        put_u64(layout.joint_count);
+        put_u64(layout.activation_count);
+        put_u64(layers.size());
+        for(const auto& layer : layers) {
+            put_u64(layer.in);
+            put_u64(layer.out);
+            put_vec(layer.W);
+            put_vec(layer.b);
+        }
+        put_vec(in_mean); put_vec(in_scale);
+        put_vec(out_mean); put_vec(out_scale);
+    }
+    
+    static SurrogateMLP load(const std::string& path) {
+        std::ifstream f(path, std::ios::binary);
+        char magic[8] = {};
+        if(!f.read(magic, 8) || std::string(magic, 8) != "AINOSURR") {
+            throw std::runtime_error("Invalid surrogate file: " + path);
+        }
+        
+        auto fail = [&](const std::string& what) {
+            throw std::runtime_error("Malformed surrogate file: " + path + " (" + what + ")");
+        };
+        auto get_u64 = [&]() {
+            uint64_t v = 0;
+            if(!f.read(reinterpret_cast<char*>(&v), sizeof(v))) fail("truncated");
+            return v;
+        };
+        // 长度先校验再分配（截断/损坏文件不会越界读或巨量分配）
+        auto get_vec = [&](std::vector<float>& v, size_t expected, const char* what) {
+            if(get_u64() != expected) fail(std::string(what) + " size mismatch");
+            v.resize(expected);
+            if(!f.read(reinterpret_cast<char*>(v.data()), expected * sizeof(float))) fail("truncated");
+        };
+        
+        SurrogateMLP model;
+        model.layout.joint_count = get_u64();
+        model.layout.activation_count = get_u64();
+        if(model.layout.joint_count > (size_t(1) << 16) || model.layout.activation_count > (size_t(1) << 16)) {
+            fail("layout");
+        }
+        const size_t layer_count = get_u64();
+        if(layer_count == 0 || layer_count > 64) fail("layer count");
+        
+        // 1. 各层维度首尾相接：输入层 = input_size()，输出层 = output_size()
+        size_t prev = model.layout.input_size();
+        model.layers.resize(layer_count);
+        for(auto& layer : model.layers) {
+            size_t in = get_u64();
+            size_t out = get_u64();
+            if(in != prev || out == 0 || out > (size_t(1) << 16)) fail("layer dimensions");
+            layer = DenseLayer(in, out);
+            get_vec(layer.W, out * layer.stride, "weight");
+            get_vec(layer.b, out, "bias");
+            prev = out;
+        }
+        if(prev != model.layout.output_size()) fail("output dimensions");
+        
+        // 2. 标准化参数
+        get_vec(model.in_mean, model.layout.input_size(), "input mean");
+        get_vec(model.in_scale, model.layout.input_size(), "input scale");
+        get_vec(model.out_mean, model.layout.output_size(), "output mean");
+        get_vec(model.out_scale, model.layout.output_size(), "output scale");
+        return model;
+    }
+};
+
+// 训练超参数
+struct TrainOptions {
+    size_t epochs = 20;
+    size_t batch_size = 64;
+    float learning_rate = 1e-3f;
+    float momentum = 0.9f;
+    uint32_t seed = 42;
+};
+
+// 离线训练（从DataRecorder采集的样本）
+class SurrogateTrainer {
+public:
+
+    // 相邻帧构造 (输入, 目标) 对
+    static void build_dataset(const std::vector<systems::TrainingSample>& samples,
+                              const SurrogateLayout& layout,
+                              std::vector<float>& inputs, std::vector<float>& targets) {
+        inputs.clear();
+        targets.clear();
+        
+        auto append = [](std::vector<float>& dst, const std::vector<float>& src, size_t n) {
+            for(size_t i = 0; i < n; ++i) dst.push_back(i < src.size() ? src[i] : 0.0f);
+        };
+        
+        for(size_t t = 1; t < samples.size(); ++t) {
+            const auto& prev = samples[t - 1];
+            const auto& cur = samples[t];
+            if(cur.timestamp <= prev.timestamp) continue; // 会话边界
+            
+            append(inputs, cur.desired_torques, layout.joint_count);
+            append(inputs, cur.stimulus_features, STIMULUS_FEATURES);
+            append(inputs, prev.muscle_activations, layout.activation_count);
+            append(inputs, prev.joint_angles, layout.joint_count);
+            
+            append(targets, cur.muscle_activations, layout.activation_count);
+            append(targets, cur.joint_angles, layout.joint_count);
+        }
+    }
+    
+    // 返回最后一轮均方误差（标准化空间）
+    static float train(SurrogateMLP& model, const std::vector<systems::TrainingSample>& samples,
+                       const TrainOptions& opt = {}) {
+        const auto& layout = model.layout;
+        const size_t ni = layout.input_size(), no = layout.output_size();
+        
+        std::vector<float> X, Y;
+        build_dataset(samples, layout, X, Y);
+        const size_t count = X.size() / ni;
+        if(count == 0) return 0.0f;
+        
+        // 1. 标准化统计
+        compute_normalization(X, ni, count, model.in_mean, model.in_scale);
+        compute_normalization(Y, no, count, model.out_mean, model.out_scale);
+        for(size_t s = 0; s < count; ++s) {
+            for(size_t i = 0; i < ni; ++i) {
+                X[s*ni + i] = (X[s*ni + i] - model.in_mean[i]) * model.in_scale[i];
+            }
+            for(size_t o = 0; o < no; ++o) {
+                Y[s*no + o] = (Y[s*no + o] - model.out_mean[o]) * model.out_scale[o];
+            }
+        }
+        
+        // 2. 梯度与动量缓冲
+        auto& layers = model.layers;
+        const size_t L = layers.size();
+        std::vector<DenseLayer> grad, velocity;
+        for(const auto& layer : layers) {
+            grad.emplace_back(layer.in, layer.out);
+            velocity.emplace_back(layer.in, layer.out);
+        }
+        
+        // 每层激活（含输入），零填充到stride
+        std::vector<std::vector<float>> act(L + 1);
+        act[0].assign(detail::padded(ni), 0.0f);
+        for(size_t l = 0; l < L; ++l) act[l + 1].assign(detail::padded(layers[l].out), 0.0f);
+        std::vector<std::vector<float>> delta(L);
+        for(size_t l = 0; l < L; ++l) delta[l].assign(layers[l].out, 0.0f);
+        
+        std::vector<size_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::mt19937 rng(opt.seed);
+        float epoch_loss = 0.0f;
+        
+        // 3. 小批量SGD + 动量
+        for(size_t epoch = 0; epoch < opt.epochs; ++epoch) {
+            std::shuffle(order.begin(), order.end(), rng);
+            epoch_loss = 0.0f;
+            
+            for(size_t start = 0; start < count; start += opt.batch_size) {
+                const size_t end = std::min(start + opt.batch_size, count);
+                for(auto& g : grad) {
+                    std::fill(g.W.begin(), g.W.end(), 0.0f);
+                    std::fill(g.b.begin(), g.b.end(), 0.0f);
+                }
+                
+                for(size_t k = start; k < end; ++k) {
+                    const float* x = &X[order[k] * ni];
+                    const float* y = &Y[order[k] * no];
+                    std::copy(x, x + ni, act[0].begin());
+                    
+                    // 前向
+                    for(size_t l = 0; l < L; ++l) {
+                        layers[l].forward(act[l].data(), act[l + 1].data());
+                        if(l + 1 < L) {
+                            for(size_t o = 0; o < layers[l].out; ++o) {
+                                act[l + 1][o] = std::tanh(act[l + 1][o]);
+                            }
+                        }
+                    }
+                    
+                    // 输出误差
+                    for(size_t o = 0; o < no; ++o) {
+                        float err = act[L][o] - y[o];
+                        delta[L - 1][o] = err;
+                        epoch_loss += err * err;
+                    }
+                    
+                    // 反向传播
+                    for(size_t l = L; l-- > 0;) {
+                        const auto& layer = layers[l];
+                        for(size_t o = 0; o < layer.out; ++o) {
+                            float d = delta[l][o];
+                            grad[l].b[o] += d;
+                            float* gw = &grad[l].W[o * layer.stride];
+                            for(size_t i = 0; i < layer.in; ++i) gw[i] += d * act[l][i];
+                        }
+                        if(l == 0) break;
+                        for(size_t i = 0; i < layer.in; ++i) {
+                            float sum = 0.0f;
+                            for(size_t o = 0; o < layer.out; ++o) {
+                                sum += layer.W[o * layer.stride + i] * delta[l][o];
+                            }
+                            float h = act[l][i];
+                            delta[l - 1][i] = sum * (1.0f - h * h); // tanh'
+                        }
+                    }
+                }
+                
+                // 参数更新
+                const float scale = opt.learning_rate / float(end - start);
+                for(size_t l = 0; l < L; ++l) {
+                    for(size_t j = 0; j < layers[l].W.size(); ++j) {
+                        velocity[l].W[j] = opt.momentum * velocity[l].W[j] - scale * grad[l].W[j];
+                        layers[l].W[j] += velocity[l].W[j];
+                    }
+                    for(size_t j = 0; j < layers[l].b.size(); ++j) {
+                        velocity[l].b[j] = opt.momentum * velocity[l].b[j] - scale * grad[l].b[j];
+                        layers[l].b[j] += velocity[l].b[j];
+                    }
+                }
+            }
+            epoch_loss /= float(count * no);
+        }
+        
+        return epoch_loss;
+    }
+    
+private:
+    static void compute_normalization(const std::vector<float>& data, size_t dim, size_t count,
+                                      std::vector<float>& mean, std::vector<float>& scale) {
+        mean.assign(dim, 0.0f);
+        scale.assign(dim, 1.0f);
+        for(size_t s = 0; s < count; ++s) {
+            for(size_t d = 0; d < dim; ++d) mean[d] += data[s*dim + d];
+        }
+        for(auto& m : mean) m /= float(count);
+        
+        std::vector<float> var(dim, 0.0f);
+        for(size_t s = 0; s < count; ++s) {
+            for(size_t d = 0; d < dim; ++d) {
+                float diff = data[s*dim + d] - mean[d];
+                var[d] += diff * diff;
+            }
+        }
+        for(size_t d = 0; d < dim; ++d) {
+            float stddev = std::sqrt(var[d] / float(count));
+            scale[d] = stddev > 1e-6f ? 1.0f / stddev : 1.0f; // 常量通道不缩放
+        }
+    }
+};
+
+} // namespace learning
+} // namespace aino_pro
@@ -0,0 +1,187 @@
+// =====================================================
+// aino_pro/systems/parareal.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include "../aino_pro.hpp"
+#include "physiological_actor.hpp"
+#include "batch_runner.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+struct PararealOptions {
+    size_t slices = 0;              // 时间切片数（0 = 线程数）
+    unsigned threads = 0;           // 0 = 硬件线程数
+    int max_iterations = 8;
+    float tolerance = 1e-3f;        // 切片边界慢变量的最大修正量
+    float coarse_dt = 0.25f;        // 粗传播步长 [s]
+};
+
+struct PararealResult {
+    std::vector<double> times;                  // 切片边界时刻
+    std::vector<std::vector<float>> states;     // 边界处慢变量
+    int iterations = 0;
+    bool converged = false;
+    float residual = 0.0f;
+    double wall_seconds = 0.0;
+};
+
+// Parareal 时间并行驱动（与具体模型无关）
+//   U[n+1] ← G(U[n]) + F(U_old[n]) − G(U_old[n])
+// 细传播 F 在各切片上并行；粗传播 G 串行但廉价
+class PararealDriver {
+public:
+    using State = std::vector<float>;
+    using Coarse = std::function<State(const State&, double t0, double t1)>;
+    using Fine = std::function<State(const State&, double t0, double t1, unsigned worker)>;
+    
+    static PararealResult solve(const State& u0, double t_end, const Coarse& coarse,
+                                const Fine& fine, const PararealOptions& opt = {}) {
+        const unsigned thread_count = opt.threads ? opt.threads :
+                                      std::max(1u, std::thread::hardware_concurrency());
+        const size_t N = std::max<size_t>(1, opt.slices ? opt.slices : thread_count);
+        auto start = std::chrono::steady_clock::now();
+        
+        PararealResult result;
+        result.times.resize(N + 1);
+        for(size_t n = 0; n <= N; ++n) result.times[n] = t_end * n / N;
+        const auto& T = result.times;
+        
+        // 1. 粗预测
+        auto& U = result.states;
+        U.assign(N + 1, u0);
+        std::vector<State> G_prev(N), F(N);
+        for(size_t n = 0; n < N; ++n) {
+            G_prev[n] = coarse(U[n], T[n], T[n + 1]);
+            U[n + 1] = G_prev[n];
+        }
+        
+        // 2. 迭代：第 k 轮后前 k+1 个切片与串行细积分完全一致
+        for(size_t k = 0; k < N && (int)k < opt.max_iterations; ++k) {
+            run_parallel(k, N, std::min<unsigned>(thread_count, (unsigned)(N - k)),
+                         [&](size_t n, unsigned worker) { F[n] = fine(U[n], T[n], T[n + 1], worker); });
+            
+            // 串行修正
+            float residual = 0.0f;
+            for(size_t n = k; n < N; ++n) {
+                State g = n == k ? G_prev[n] : coarse(U[n], T[n], T[n + 1]);
+                State next(g.size());
+                for(size_t i = 0; i < next.size(); ++i) {
+                    next[i] = g[i] + F[n][i] - G_prev[n][i];
+                    residual = std::max(residual, std::abs(next[i] - U[n + 1][i]));
+                }
+                G_prev[n] = std::move(g);
+                U[n + 1] = std::move(next);
+            }
+            
+            result.iterations = (int)k + 1;
+            result.residual = residual;
+            if(residual <= opt.tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+        if(result.iterations == (int)N) result.converged = true;
+        
+        result.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    
+private:
+    // 切片 [begin, end) 按原子计数分发到工作线程
+    template<typename Fn>
+    static void run_parallel(size_t begin, size_t end, unsigned thread_count, Fn&& fn) {
+        std::atomic<size_t> next{begin};
+        std::vector<std::exception_ptr> errors(thread_count);
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count);
+        for(unsigned w = 0; w < thread_count; ++w) {
+            workers.emplace_back([&, w] {
+                try {
+                    for(size_t n = next++; n < end; n = next++) fn(n, w);
+                } catch(...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+        for(auto& t : workers) t.join();
+        for(auto& e : errors) {
+            if(e) std::rethrow_exception(e);
+        }
+    }
+};
+
+// 单角色长时仿真的 Parareal 运行器
+//   慢变量 = 代谢、心境、肌肉结合比例（PhysiologicalActor::save_slow_state）
+//   粗传播：矩模型 + 大步长；细传播：Huxley网格 + 场景步长
+//   每次传播从检查点恢复角色（restore_slow_state 同时把骨骼/神经等快变量复位，切片内重新建立）
+//   粗传播串行调用，整个运行复用一个预分配角色；细传播各切片并行，每切片新建
+class PararealRunner {
+public:
+    static PararealResult run(const Scenario& sc, const PararealOptions& opt = {}) {
+        const unsigned thread_count = opt.threads ? opt.threads :
+                                      std::max(1u, std::thread::hardware_concurrency());
+        
+        ContextOptions ctx_opt;
+        ctx_opt.enable_recorder = false;
+        ctx_opt.thread_budget = 1;
+        
+        // 细传播：每线程独立上下文，不受帧预算截断
+        Config fine_cfg = sc.config;
+        fine_cfg.budget.cpu_ms_per_frame = 1.0e9f;
+        std::vector<std::unique_ptr<EngineContext>> fine_ctx;
+        for(unsigned w = 0; w < thread_count; ++w) {
+            fine_ctx.push_back(std::make_unique<EngineContext>(fine_cfg, ctx_opt));
+        }
+        EngineContext coarse_ctx(sc.config, ctx_opt);
+        
+        LodLevel coarse_level;
+        coarse_level.muscle_model = MuscleModel::Moment;
+        coarse_level.grid_size = 10;
+        coarse_level.run_tendons = false;
+        
+        auto propagate = [&sc](PhysiologicalActor& actor, const std::vector<float>& u,
+                               double t0, double t1, double max_dt) {
+            actor.restore_slow_state(u);
+            const size_t steps = std::max<size_t>(1, (size_t)std::ceil((t1 - t0) / max_dt));
+            const float dt = float((t1 - t0) / steps);
+            PhysioBridge input;
+            for(size_t s = 0; s < steps; ++s) {
+                sc.input_at(t0 + s * (double)dt, input);
+                actor.update(dt, input);
+            }
+            return actor.save_slow_state();
+        };
+        
+        // 粗 / 细传播线程内的 OpenMP 并行区按上下文预算（单线程）运行，避免 线程数 × 核数 超订
+        PhysiologicalActor coarse_actor(sc.muscle_count, &coarse_ctx);
+        coarse_actor.apply_lod(0, coarse_level);
+        auto coarse = [&](const std::vector<float>& u, double t0, double t1) {
+            const ThreadBudgetScope budget(coarse_ctx.get_thread_budget());
+            return propagate(coarse_actor, u, t0, t1, std::max(opt.coarse_dt, sc.dt));
+        };
+        
+        auto fine = [&](const std::vector<float>& u, double t0, double t1, unsigned worker) {
+            const ThreadBudgetScope budget(fine_ctx[worker]->get_thread_budget());
+            PhysiologicalActor actor(sc.muscle_count, fine_ctx[worker].get());
+            return propagate(actor, u, t0, t1, sc.dt);
+        };
+        
+        PararealOptions driver_opt = opt;
+        driver_opt.threads = thread_count;
+        return PararealDriver::solve(coarse_actor.save_slow_state(), sc.duration, coarse, fine, driver_opt);
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -0,0 +1,368 @@
+// =====================================================
+// perf_counters.hpp - 硬件性能计数器（Linux perf_event_open）
+// =====================================================
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+// 仅 Linux 可用；其他平台或无头文件时全部计数器报告不可用
+#if !defined(AINO_HW_COUNTERS)
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define AINO_HW_COUNTERS 1
+#else
+#define AINO_HW_COUNTERS 0
+#endif
+#endif
+#if AINO_HW_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aino_pro {
+
+enum class HwEvent : uint8_t {
+    Cycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    StalledFrontend,    // 前端停顿周期（取指/译码）
+    StalledBackend,     // 后端停顿周期（访存/执行单元）
+    TaskClock,          // 软件事件 [ns]，无PMU时的退化基准
+    COUNT
+};
+
+static constexpr size_t HW_EVENT_COUNT = size_t(HwEvent::COUNT);
+
+inline const char* hw_event_name(HwEvent e) {
+    static const char* NAMES[] = {"cycles", "instructions", "cache_misses", "branch_misses",
+                                  "stalled_cycles_frontend", "stalled_cycles_backend", "task_clock_ns"};
+    return e < HwEvent::COUNT ? NAMES[size_t(e)] : "unknown";
+}
+
+// 一组计数值；available 位 i 表示 value[i] 有效
+struct HwSample {
+    std::array<uint64_t, HW_EVENT_COUNT> value{};
+    uint32_t available = 0;
+    
+    [[nodiscard]] bool has(HwEvent e) const { return (available >> size_t(e)) & 1u; }
+    [[nodiscard]] uint64_t get(HwEvent e) const { return value[size_t(e)]; }
+    
+    HwSample& operator+=(const HwSample& o) {
+        for(size_t i = 0; i < HW_EVENT_COUNT; ++i) value[i] += o.value[i];
+        available |= o.available;
+        return *this;
+    }
+    
+    [[nodiscard]] double ipc() const {
+        return has(HwEvent::Cycles) && has(HwEvent::Instructions) && get(HwEvent::Cycles)
+            ? double(get(HwEvent::Instructions)) / double(get(HwEvent::Cycles)) : 0.0;
+    }
+};
+
+// 每线程计数器：硬件事件一组（一次 read 取全部），软件事件单独
+// 计数按 time_enabled / time_running 换算（PMU复用时外推）
+class ThreadCounters {
+public:
+    static constexpr size_t MAX_SLOTS = 16;     // 累计槽位（流水线按 PipelineStage 编号）
+    
+private:
+    std::array<int, HW_EVENT_COUNT> fds;
+    std::array<int, HW_EVENT_COUNT> group_pos;  // 组内位置（-1 = 不在组内）
+    int group_fd = -1;
+    size_t group_size = 0;
+    uint32_t opened = 0;
+    const uint32_t thread_index;
+    
+    // 各槽位累计（所属线程写，任意线程读）
+    std::array<std::array<std::atomic<uint64_t>, HW_EVENT_COUNT>, MAX_SLOTS> totals{};
+    std::array<std::atomic<uint32_t>, MAX_SLOTS> totals_available{};
+    
+    // 读取结果：成功换算过的事件位 / 读到 time_running = 0（已启用但从未调度到PMU）的事件位
+    mutable std::atomic<uint32_t> ran{0};
+    mutable std::atomic<uint32_t> idle{0};
+    
+public:
+    explicit ThreadCounters(uint32_t index) : thread_index(index) {
+        fds.fill(-1);
+        group_pos.fill(-1);
+    }
+    
+    ~ThreadCounters() { close(); }
+    
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+    
+    // 须在所属线程调用（pid = 0 绑定调用线程）；返回成功打开的事件位
+    uint32_t open(std::string& status) {
+#if AINO_HW_COUNTERS
+        static const std::pair<HwEvent, uint64_t> HARDWARE[] = {
+            {HwEvent::Cycles, PERF_COUNT_HW_CPU_CYCLES},
+            {HwEvent::Instructions, PERF_COUNT_HW_INSTRUCTIONS},
+            {HwEvent::CacheMisses, PERF_COUNT_HW_CACHE_MISSES},
+            {HwEvent::BranchMisses, PERF_COUNT_HW_BRANCH_MISSES},
+            {HwEvent::StalledFrontend, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+            {HwEvent::StalledBackend, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+        };
+        int first_error = 0;
+        for(const auto& [event, config] : HARDWARE) {
+            int fd = open_event(PERF_TYPE_HARDWARE, config, group_fd);
+            if(fd < 0) {
+                if(!first_error) first_error = errno;
+                continue;
+            }
+            if(group_fd < 0) group_fd = fd;
+            fds[size_t(event)] = fd;
+            group_pos[size_t(event)] = (int)group_size++;
+            opened |= 1u << size_t(event);
+        }
+        int fd = open_event(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, -1);
+        if(fd >= 0) {
+            fds[size_t(HwEvent::TaskClock)] = fd;
+            opened |= 1u << size_t(HwEvent::TaskClock);
+        } else if(!first_error) {
+            first_error = errno;
+        }
+        if(first_error) {
+            status = std::string("some counters unavailable: ") + std::strerror(first_error) +
+                     (first_error == EACCES || first_error == EPERM ? " (check kernel.perf_event_paranoid)" : "");
+        }
+#else
+        status = "perf_event_open not supported on this platform";
+#endif
+        return opened;
+    }
+    
+    void close() {
+#if AINO_HW_COUNTERS
+        for(int& fd : fds) {
+            if(fd >= 0 && fd != group_fd) ::close(fd);
+            fd = -1;
+        }
+        if(group_fd >= 0) ::close(group_fd);
+#endif
+        group_fd = -1;
+        group_size = 0;
+        opened = 0;
+    }
+    
+    // 当前累计值（单调递增）；无可用事件时返回 false
+    bool read(HwSample& out) const {
+        out.available = 0;
+#if AINO_HW_COUNTERS
+        if(group_fd >= 0) {
+            // PERF_FORMAT_GROUP | TOTAL_TIME_*: nr, time_enabled, time_running, value[nr]
+            uint64_t buf[3 + HW_EVENT_COUNT];
+            ssize_t n = ::read(group_fd, buf, sizeof(uint64_t) * (3 + group_size));
+            if(n == ssize_t(sizeof(uint64_t) * (3 + group_size))) {
+                if(buf[2] > 0) {
+                    const double scale = double(buf[1]) / double(buf[2]);
+                    for(size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+                        if(group_pos[e] < 0) continue;
+                        out.value[e] = uint64_t(double(buf[3 + group_pos[e]]) * scale);
+                        out.available |= 1u << e;
+                    }
+                } else {
+                    idle.fetch_or(opened & ~(1u << size_t(HwEvent::TaskClock)), std::memory_order_relaxed);
+                }
+            }
+        }
+        if(int fd = fds[size_t(HwEvent::TaskClock)]; fd >= 0) {
+            uint64_t buf[3];
+            if(::read(fd, buf, sizeof(buf)) == ssize_t(sizeof(buf))) {
+                if(buf[2] > 0) {
+                    out.value[size_t(HwEvent::TaskClock)] = uint64_t(double(buf[0]) * double(buf[1]) / double(buf[2]));
+                    out.available |= 1u << size_t(HwEvent::TaskClock);
+                } else {
+                    idle.fetch_or(1u << size_t(HwEvent::TaskClock), std::memory_order_relaxed);
+                }
+            }
+        }
+        if(out.available) ran.fetch_or(out.available, std::memory_order_relaxed);
+#endif
+        return out.available != 0;
+    }
+    
+    // 把区间差值累加到槽位（仅所属线程调用）
+    void accumulate(size_t slot, const HwSample& from, const HwSample& to) {
+        if(slot >= MAX_SLOTS) return;
+        const uint32_t both = from.available & to.available;
+        for(size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+            if(!((both >> e) & 1u) || to.value[e] < from.value[e]) continue;
+            auto& t = totals[slot][e];
+            t.store(t.load(std::memory_order_relaxed) + (to.value[e] - from.value[e]), std::memory_order_relaxed);
+        }
+        totals_available[slot].fetch_or(both, std::memory_order_relaxed);
+    }
+    
+    [[nodiscard]] HwSample slot_total(size_t slot) const {
+        HwSample s;
+        if(slot >= MAX_SLOTS) return s;
+        for(size_t e = 0; e < HW_EVENT_COUNT; ++e) s.value[e] = totals[slot][e].load(std::memory_order_relaxed);
+        s.available = totals_available[slot].load(std::memory_order_relaxed);
+        return s;
+    }
+    
+    void reset_totals() {
+        for(size_t slot = 0; slot < MAX_SLOTS; ++slot) {
+            for(auto& t : totals[slot]) t.store(0, std::memory_order_relaxed);
+            totals_available[slot].store(0, std::memory_order_relaxed);
+        }
+    }
+    
+    [[nodiscard]] uint32_t get_thread_index() const { return thread_index; }
+    [[nodiscard]] uint32_t available() const { return opened; }
+    
+    // 至少一次读到有效值的事件
+    [[nodiscard]] uint32_t counted() const { return ran.load(std::memory_order_relaxed); }
+    
+    // 已打开、读取过但从未计数的事件（PMU被占用 / 虚拟机未透传）
+    [[nodiscard]] uint32_t never_ran() const {
+        return idle.load(std::memory_order_relaxed) & ~ran.load(std::memory_order_relaxed);
+    }
+    
+private:
+#if AINO_HW_COUNTERS
+    static int open_event(uint32_t type, uint64_t config, int group) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING |
+                           (type == PERF_TYPE_HARDWARE ? PERF_FORMAT_GROUP : 0);
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, type == PERF_TYPE_HARDWARE ? group : -1, 0);
+    }
+#endif
+};
+
+// 每线程一个快照
+struct ThreadCounterProfile {
+    uint32_t thread_index = 0;
+    std::array<HwSample, ThreadCounters::MAX_SLOTS> slots;
+};
+
+// 进程级注册：线程首次读取时打开计数器（仅此处加锁）
+// 默认关闭；开启后每次读取为一到两次 read 系统调用（约1µs），用于分析而非常驻
+class HardwareCounters {
+    std::atomic<bool> enabled{false};
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadCounters>> threads;
+    std::string status = "not opened";
+    uint32_t available_mask = 0;
+    
+    // 线程退出时关闭该线程的 perf fd；ThreadCounters 留在 threads 中，只保留累计值供汇总
+    struct ThreadGuard {
+        std::shared_ptr<ThreadCounters> counters;
+        ~ThreadGuard() { if(counters) counters->close(); }
+    };
+    
+    HardwareCounters() = default;
+    
+public:
+    static HardwareCounters& instance() {
+        static HardwareCounters counters;
+        return counters;
+    }
+    
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+    
+    void set_enabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    [[nodiscard]] bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    
+    // 当前线程的计数器；全部事件不可用时返回 nullptr（调用方跳过计数）
+    ThreadCounters* this_thread() {
+        thread_local ThreadCounters* t_counters = nullptr;
+        thread_local ThreadGuard t_guard;
+        thread_local bool t_tried = false;
+        if(!t_tried) {
+            t_tried = true;
+            std::string why;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto counters = std::make_shared<ThreadCounters>((uint32_t)threads.size());
+            uint32_t mask = counters->open(why);
+            available_mask |= mask;
+            if(!why.empty()) status = why;
+            else if(!mask) status = "no counters available";
+            else if(status == "not opened") status = "ok";
+            if(mask) {
+                threads.push_back(counters);
+                t_counters = counters.get();
+                t_guard.counters = std::move(counters);
+            }
+        }
+        return t_counters;
+    }
+    
+    [[nodiscard]] std::vector<ThreadCounterProfile> snapshot() const {
+        std::vector<std::shared_ptr<ThreadCounters>> current;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = threads;
+        }
+        std::vector<ThreadCounterProfile> out(current.size());
+        for(size_t i = 0; i < current.size(); ++i) {
+            out[i].thread_index = current[i]->get_thread_index();
+            for(size_t s = 0; s < ThreadCounters::MAX_SLOTS; ++s) out[i].slots[s] = current[i]->slot_total(s);
+        }
+        return out;
+    }
+    
+    // 全部线程按槽位求和
+    [[nodiscard]] std::array<HwSample, ThreadCounters::MAX_SLOTS> totals() const {
+        std::array<HwSample, ThreadCounters::MAX_SLOTS> sum{};
+        for(const auto& t : snapshot()) {
+            for(size_t s = 0; s < sum.size(); ++s) sum[s] += t.slots[s];
+        }
+        return sum;
+    }
+    
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& t : threads) t->reset_totals();
+    }
+    
+    // 退化原因（"ok" / 不可用事件与 errno / 从未计数的事件）
+    [[nodiscard]] std::string get_status() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint32_t idle = never_ran_locked();
+        if(!idle) return status;
+        std::string names;
+        for(size_t e = 0; e < HW_EVENT_COUNT; ++e) {
+            if((idle >> e) & 1u) names += std::string(names.empty() ? "" : ", ") + hw_event_name(HwEvent(e));
+        }
+        std::string why = "counters never ran (time_running = 0, PMU busy or not exposed): " + names;
+        return status == "ok" ? why : status + "; " + why;
+    }
+    
+    // 打开且实际计过数的事件位
+    [[nodiscard]] uint32_t available() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return available_mask & ~never_ran_locked();
+    }
+    
+private:
+    // 任一线程读到过有效值即视为运行过
+    [[nodiscard]] uint32_t never_ran_locked() const {
+        uint32_t idle = 0, ran = 0;
+        for(const auto& t : threads) {
+            idle |= t->never_ran();
+            ran |= t->counted();
+        }
+        return idle & ~ran;
+    }
+};
+
+} // namespace aino_pro
@@ -3,6 +3,7 @@
 // =====================================================
 
 #pragma once
+#include "../aino_pro.hpp"
 #include "../biology/muscle_huxley.hpp"
 #include "../biology/metabolism.hpp"
 #include "../biology/multibody.hpp"
@@ -10,9 +11,14 @@
 #include "../neuroscience/spinal_circuit.hpp"
 #include "../psychology/emotion_model.hpp"
 #include "../psychology/cognitive_appraisal.hpp"
+#include "../learning/muscle_surrogate.hpp"
+#include "lod_policy.hpp"
+#include "stimulus_queue.hpp"
+#include "emotion_muscle_map.hpp"
 #include "../aino_animation.hpp"
 #include <chrono>
 #include <numeric>
+#include <stdexcept>
 
 namespace aino_pro {
 namespace systems {
@@ -20,24 +26,101 @@ namespace systems {
 struct PhysioBridge {
     std::vector<float> desired_joint_torques;
     std::vector<psychology::Stimulus> cognitive_stimuli;
+    // 类型化输入通道（构图时绑定上游缓冲，零拷贝）；绑定后优先于上面的自有向量
+    aino_animation::InputChannel<float> torque_channel;
+    aino_animation::InputChannel<psychology::Stimulus> stimulus_channel;
+    const psychology::StimulusBatch* perceived = nullptr;  // 空间索引查询结果（已按距离衰减）
+    const psychology::CrowdAppraisal* broadcast = nullptr; // 广播评估结果（本角色位于 broadcast_index）
+    size_t broadcast_index = 0;
+    const psychology::EmotionBank* social = nullptr;        // 情绪传染结果（本角色位于 social_index）
+    size_t social_index = 0;
     
-    std::vector<float> muscle_activations;
+    std::vector<float> muscle_activations;   // 每节段净驱动（屈 − 伸，[-1, 1]），驱动肌肉 2s / 2s+1
     std::vector<aino_math::Vec3> joint_angles;
     float fatigue_factor = 0.0f;
+    
+    [[nodiscard]] aino_animation::Span<float> torques() const {
+        return torque_channel.bound() ? torque_channel.view() : aino_animation::Span<float>(desired_joint_torques);
+    }
+    [[nodiscard]] aino_animation::Span<psychology::Stimulus> stimuli() const {
+        return stimulus_channel.bound() ? stimulus_channel.view() : aino_animation::Span<psychology::Stimulus>(cognitive_stimuli);
+    }
+};
+
+static_assert(STAGE_COUNT <= ThreadCounters::MAX_SLOTS, "stage slots exceed hardware counter slots");
+
+// 逐阶段累计耗时：每次 lap 把距上次的时间记到指定阶段（未开启时不读时钟）
+// 计时区开启时同时把每个阶段写入 Profiler（区名 = stage_name）
+// 硬件计数器开启时按阶段累加到本线程计数器（只计调用线程，不含嵌套OpenMP工作线程）
+class StageTimer {
+    std::chrono::steady_clock::time_point last;
+    float* stage_ms = nullptr;
+    ThreadCounters* counters = nullptr;
+    HwSample counters_last;
+#if AINO_PROFILE
+    ZoneChain zones;
+#endif
+
+public:
+    void begin(float* out) {
+#if AINO_PROFILE
+        zones.begin();
+#endif
+        counters = nullptr;
+        if(HardwareCounters::instance().is_enabled()) {
+            counters = HardwareCounters::instance().this_thread();
+            if(counters && !counters->read(counters_last)) counters = nullptr;
+        }
+        stage_ms = out;
+        if(!stage_ms) return;
+        std::fill(stage_ms, stage_ms + STAGE_COUNT, 0.0f);
+        last = std::chrono::steady_clock::now();
+    }
+    
+    void lap(PipelineStage stage) {
+#if AINO_PROFILE
+        zones.lap(stage_name(stage));
+#endif
+        if(counters) {
+            HwSample now;
+            if(counters->read(now)) {
+                counters->accumulate(size_t(stage), counters_last, now);
+                counters_last = now;
+            }
+        }
+        if(!stage_ms) return;
+        auto now = std::chrono::steady_clock::now();
+        stage_ms[size_t(stage)] += std::chrono::duration<float, std::milli>(now - last).count();
+        last = now;
+    }
 };
 
 class PhysiologicalActor : public aino_animation::AnimationNodeBase {
+    EngineContext* context;
+    const uint64_t actor_id;
     std::vector<biology::Muscle> muscles;
     std::vector<biology::TendonNonlinear> tendons;
+    std::vector<float> tendon_stress;   // 最近一次肌腱阶段的应力 [Pa]
     biology::ArticulatedSkeleton skeleton;
     biology::MetabolicSystem metabolism;
     neuroscience::SpinalCord spinal_cord;
     psychology::CognitiveAppraiser appraiser;
     psychology::MoodDynamics mood;
     psychology::EmotionProfile current_emotion;
+    psychology::StimulusBatch stimulus_batch;
+    psychology::AppraisalTraits traits{0.7f, 0.8f, 0.0f};
+    
+    // 跨线程刺激收件箱（可选；帧起点排空）
+    std::unique_ptr<StimulusQueue> inbox;
+    psychology::StimulusBatch inbox_batch;
     
     PhysioBridge bridge;
     
+    // 神经代理（Accuracy::Surrogate）
+    std::shared_ptr<const learning::SurrogateMLP> surrogate;
+    learning::SurrogateMLP::Workspace surrogate_ws;
+    std::vector<float> surrogate_in, surrogate_out;
+    
     // 肌肉索引常量（避免魔数）
     enum MuscleIndex {
         TRAPEZIUS = 0,
@@ -46,113 +129,407 @@ class PhysiologicalActor : public aino_animation::AnimationNodeBase {
         // ... 可扩展
         MUSCLE_COUNT = 50
     };
+    static constexpr float MAX_JOINT_TORQUE = 20.0f;   // 单侧满激活时的关节扭矩 [N·m]
+    
+    // 每角色LOD
+    int lod_index = 0;
+    int applied_grid = 0;
+    LodLevel lod;
+    int lod_frame = 0;
+    float lod_dt_accum = 0.0f;
+    int metabolism_frame = 0;
+    double record_time = 0.0;
+    std::shared_ptr<const BakedClip> baked_clip;
+    double baked_time = 0.0;
+    aino_math::Vec3 world_position;
+    float perception_radius = 20.0f;   // [m]
+    
+    // 情绪姿态：情绪 → 每肌肉激活偏置
+    std::shared_ptr<const EmotionMuscleMap> emotion_map;
+    std::vector<float> emotion_drive;
+    
+    // 肌肉精算排序缓冲（复用避免分配）
+    std::vector<size_t> refine_order;
+    std::vector<float> refine_priority;
     
     struct Performance {
         float last_frame_ms = 0.0f;
         size_t muscle_updates = 0;
         bool is_thermal_throttling = false;
+        std::array<float, STAGE_COUNT> stage_ms{};  // 最近一次评估帧（stage_timing 开启时）
     } perf;
+    bool stage_timing = false;
     
 public:
-    explicit PhysiologicalActor(size_t muscle_count = MUSCLE_COUNT)
-        : muscles(muscle_count), tendons(muscle_count), 
-          spinal_cord(muscle_count / 2) {
+    // 角色绑定到一个引擎上下文（默认为 Engine 全局上下文）
+    explicit PhysiologicalActor(size_t muscle_count = MUSCLE_COUNT, EngineContext* ctx = nullptr)
+        : context(ctx ? ctx : &Engine::default_context()), actor_id(next_id()),
+          muscles(muscle_count), tendons(muscle_count), tendon_stress(muscle_count, 0.0f),
+          spinal_cord(muscle_count / 2),
+          emotion_map(default_emotion_map()),
+          emotion_drive(muscle_count, 0.0f) {
         initialize_human_muscles();
+        sync_grid_size(context->get_config()->accuracy);
+        context->muscles().add(this, &muscles);
+    }
+    
+    ~PhysiologicalActor() override {
+        context->muscles().remove(this);
     }
     
-    // 主更新循环
+    // 注册表持有肌肉地址，禁止拷贝/移动
+    PhysiologicalActor(const PhysiologicalActor&) = delete;
+    PhysiologicalActor& operator=(const PhysiologicalActor&) = delete;
+    
+    [[nodiscard]] EngineContext& get_context() const { return *context; }
+    [[nodiscard]] uint64_t get_id() const { return actor_id; }
+    
+    // 主更新循环（运行时检查功能开关；批量特化见 actor_pipeline.hpp）
     void update(float dt, const PhysioBridge& input) {
+        run_pipeline<FEATURE_ALL, Accuracy::Standard, true>(dt, input, *context->get_config());
+    }
+    
+    // 编译期流水线：Features 中关闭的阶段连同分支一起被裁掉
+    // Dynamic = true 时按 cfg 做运行时检查（未特化组合的通用回退）
+    template<uint32_t Features, Accuracy Acc, bool Dynamic = false>
+    void run_pipeline(float dt, const PhysioBridge& input, const Config& cfg) {
         auto start = std::chrono::high_resolution_clock::now();
+        auto frame_start = std::chrono::steady_clock::now();
         
-        // 1. 认知评估 → 情绪
-        current_emotion = psychology::EmotionProfile();
-        for(const auto& stim : input.cognitive_stimuli) {
-            aino_animation::AnimationContext ctx; // 临时上下文
-            ctx.parameters["self_efficacy"] = 0.7f;
-            ctx.parameters["self_esteem"] = 0.8f;
-            ctx.emotion.mood.stress = current_emotion.mood.stress;
-            
-            auto result = appraiser.appraise(stim, ctx);
-            
-            // 情绪混合（最大值策略）
-            if(result.goal_relevance > 0.2f) {
-                blend_emotions_max(current_emotion, result.emotion);
-            }
-        }
+        const uint32_t runtime_mask = Dynamic ? feature_mask(cfg.features) : Features;
+        const Accuracy accuracy = Dynamic ? cfg.accuracy : Acc;
+        auto enabled = [&](uint32_t bit) { return !Dynamic || (runtime_mask & bit) != 0; };
+        const ThreadBudgetScope thread_budget(context->get_thread_budget());
+        const bool metrics_on = context->metrics().is_enabled();
+        StageTimer timer;
+        timer.begin(stage_timing || metrics_on ? perf.stage_ms.data() : nullptr);
         
-        // 2. 心境更新
-        mood.update(dt, current_emotion);
-        current_emotion.mood = mood.get_state();
+        // 0. 排空收件箱（降频跳过的帧也排空，刺激累积到下次评估）
+        if(inbox) drain_into(*inbox, inbox_batch);
         
-        // 3. 脊髓反射 → 肌肉激活
-        spinal_cord.set_emotional_modulation(current_emotion.primary.fear);
-        spinal_cord.step(input.desired_joint_torques, dt);
-        bridge.muscle_activations = spinal_cord.get_muscle_activations();
+        // LOD降频：跳过的帧只累积时间
+        lod_dt_accum += dt;
+        if(++lod_frame % std::max(lod.update_interval, 1) != 0) {
+            timer.lap(PipelineStage::Input);
+            return;
+        }
+        dt = lod_dt_accum;
+        lod_dt_accum = 0.0f;
+        timer.lap(PipelineStage::Input);
         
-        // 4. 情绪→肌肉微调
-        apply_emotion_to_muscles(current_emotion);
+        bool emotion_ran = false;
+        if constexpr((Features & FEATURE_EMOTION) != 0) {
+            if(enabled(FEATURE_EMOTION) && lod.run_emotion) {
+                // 1. 认知评估 → 情绪（SoA批量，最大值混合）
+                const auto stimuli = input.stimuli();
+                stimulus_batch.assign(stimuli.data(), stimuli.size());
+                traits.stress = mood.get_state().stress;
+                current_emotion = psychology::EmotionProfile();
+                appraiser.appraise_batch(stimulus_batch, traits, current_emotion);
+                if(input.perceived) appraiser.appraise_batch(*input.perceived, traits, current_emotion);
+                if(!inbox_batch.empty()) appraiser.appraise_batch(inbox_batch, traits, current_emotion);
+                if(input.broadcast && input.broadcast_index < input.broadcast->size()) {
+                    input.broadcast->merge_into(input.broadcast_index, current_emotion);
+                }
+                if(input.social && input.social_index < input.social->size()) {
+                    input.social->merge_row_max(input.social_index, current_emotion);
+                }
+                
+                // 2. 心境更新
+                mood.update(dt, current_emotion);
+                current_emotion.mood = mood.get_state();
+                emotion_ran = true;
+            }
+        }
         
-        // 5. 肌肉动力学
-        update_muscles_parallel(dt);
+        inbox_batch.clear();
+        timer.lap(PipelineStage::Emotion);
         
-        // 6. 肌腱滞后
-        if(Engine::get_config().features.enable_hysteresis) {
-            update_tendons(dt);
+        const MuscleModel model = active_muscle_model(accuracy);
+        if(model == MuscleModel::Baked) {
+            // 3-6. 烘焙回放：直接驱动关节角
+            play_baked(dt);
+            timer.lap(PipelineStage::Muscle);
+        } else if(model == MuscleModel::Surrogate) {
+            // 3-6. 神经代理：一次推理替代 脊髓→肌肉→肌腱→骨骼
+            run_surrogate(input);
+            for(size_t i = 0; i < muscles.size(); ++i) {
+                muscles[i].estimate(muscle_activation(i), dt); // 保持矩模型状态，便于切回
+            }
+            timer.lap(PipelineStage::Muscle);
+        } else {
+            sync_grid_size(accuracy);
+            
+            // 3. 脊髓反射 → 肌肉激活
+            bool neural_ran = false;
+            if constexpr((Features & FEATURE_NEURAL) != 0) {
+                if(enabled(FEATURE_NEURAL) && lod.run_neural) {
+                    spinal_cord.set_emotional_modulation(current_emotion.primary.fear);
+                    const auto torques = input.torques();
+                    spinal_cord.step(torques.data(), torques.size(), dt);
+                    bridge.muscle_activations = spinal_cord.get_muscle_activations();
+                    neural_ran = true;
+                }
+            }
+            if(!neural_ran) {
+                activations_from_torques(input.torques());
+            }
+            
+            // 4. 情绪→肌肉偏置（稀疏矩阵，叠加到神经驱动，不额外积分）
+            if(emotion_ran) {
+                emotion_map->apply(current_emotion, emotion_drive);
+            } else {
+                std::fill(emotion_drive.begin(), emotion_drive.end(), 0.0f);
+            }
+            timer.lap(PipelineStage::Neural);
+            
+            // 5. 肌肉动力学（截止时间 = 世界帧起点 + 肌肉阶段预算，全部角色共享）
+            const auto& budget = cfg.budget;
+            auto deadline = context->frame_deadline(budget.cpu_ms_per_frame * budget.muscle_update_ratio, frame_start);
+            update_muscles_parallel(dt, deadline, model == MuscleModel::Huxley);
+            timer.lap(PipelineStage::Muscle);
+            
+            // 6. 肌腱滞后
+            if constexpr((Features & FEATURE_HYSTERESIS) != 0) {
+                if(enabled(FEATURE_HYSTERESIS) && lod.run_tendons) {
+                    update_tendons(dt);
+                }
+            }
+            timer.lap(PipelineStage::Tendon);
         }
         
         // 7. 代谢（降频）
-        static int frame_counter = 0;
-        if(++frame_counter % 4 == 0) {
-            float total_activation = std::accumulate(bridge.muscle_activations.begin(),
-                                                    bridge.muscle_activations.end(), 0.0f);
-            metabolism.update(total_activation, dt * 4.0f);
+        if constexpr((Features & FEATURE_METABOLISM) != 0) {
+            if(enabled(FEATURE_METABOLISM) && lod.run_metabolism && ++metabolism_frame % 4 == 0) {
+                float total_activation = std::accumulate(bridge.muscle_activations.begin(),
+                                                        bridge.muscle_activations.end(), 0.0f);
+                metabolism.update(total_activation, dt * 4.0f);
+            }
         }
+        timer.lap(PipelineStage::Metabolism);
         
-        // 8. 骨骼动力学
-        skeleton.forward_dynamics(dt);
+        // 8. 骨骼动力学（屈 / 伸肌力差 → 关节扭矩）
+        if(model == MuscleModel::Huxley || model == MuscleModel::Moment) {
+            apply_muscle_torques();
+            skeleton.forward_dynamics(dt);
+        }
+        timer.lap(PipelineStage::Skeleton);
         
         // 9. 输出
         bridge.joint_angles = skeleton.get_joint_angles();
-        bridge.fatigue_factor = metabolism.get_fatigue_factor();
+        bridge.fatigue_factor = 0.0f;
+        if constexpr((Features & FEATURE_FATIGUE) != 0) {
+            if(enabled(FEATURE_FATIGUE)) {
+                bridge.fatigue_factor = metabolism.get_fatigue_factor();
+            }
+        }
+        timer.lap(PipelineStage::Output);
         
         // 10. 数据记录
-        auto* recorder = Engine::get_recorder();
+        auto* recorder = context->get_recorder();
         if(recorder) {
-            static double timestamp = 0.0;
-            timestamp += dt;
+            record_time += dt;
+            
+            systems::TrainingSample sample;
+            sample.timestamp = record_time;
+            auto emotion_vec = current_emotion.to_vector();
+            sample.emotion_vector.assign(emotion_vec.begin(), emotion_vec.end());
+            sample.metabolism_state = metabolism.get_state();
+            sample.muscle_activations = bridge.muscle_activations;
+            // 姿态量化可扩展
+            
+            const auto torques = input.torques();
+            const auto stimuli = input.stimuli();
+            sample.desired_torques.assign(torques.begin(), torques.end());
+            auto stim_feat = learning::stimulus_features(stimuli.data(), stimuli.size());
+            sample.stimulus_features.assign(stim_feat.begin(), stim_feat.end());
+            sample.joint_angles.reserve(bridge.joint_angles.size());
+            for(const auto& a : bridge.joint_angles) sample.joint_angles.push_back(a.z);
             
-            recorder->record_frame({
-                timestamp,
-                current_emotion.to_vector(),
-                metabolism.get_state(),
-                bridge.muscle_activations,
-                {} // 姿态量化可扩展
-            });
+            recorder->record_frame(sample);
         }
+        timer.lap(PipelineStage::Record);
         
         auto end = std::chrono::high_resolution_clock::now();
         perf.last_frame_ms = std::chrono::duration<float, std::milli>(end - start).count();
+        context->report_frame(perf.last_frame_ms, perf.muscle_updates, perf.is_thermal_throttling);
+        if(metrics_on) {
+            context->metrics().record_actor_frame(actor_id, lod_index, perf.stage_ms.data(),
+                                                  perf.last_frame_ms, context->actor_budget_ms(cfg.budget.cpu_ms_per_frame));
+        }
+    }
+    
+    // 每帧由世界调用：根据相机/重要度选择LOD
+    void update_lod(const LodPolicy& policy, const LodInput& in) {
+        int level = policy.select(in, lod_index);
+        if(level != lod_index) {
+            apply_lod(level, policy.level(level));
+        }
+    }
+    
+    // 切换LOD档位并在模型间投影状态
+    void apply_lod(int index, const LodLevel& level) {
+        const Accuracy accuracy = context->get_config()->accuracy;
+        const MuscleModel prev_model = active_muscle_model(accuracy);
+        const float prev_fraction = lod.fiber_fraction;
+        
+        lod_index = index;
+        lod = level;
+        for(auto& m : muscles) m.set_fiber_fraction(level.fiber_fraction);
+        
+        // 矩模型 → Huxley网格（含新启用的纤维）
+        if(active_muscle_model(accuracy) == MuscleModel::Huxley &&
+           (prev_model != MuscleModel::Huxley || level.fiber_fraction > prev_fraction)) {
+            for(auto& m : muscles) m.project_moment_to_fibers();
+        }
+        
+        lod_frame = 0;
+        lod_dt_accum = 0.0f;
+    }
+    
+    [[nodiscard]] int get_lod() const { return lod_index; }
+    [[nodiscard]] const Performance& get_performance() const { return perf; }
+    
+    // 分阶段计时（默认关闭；开启后每帧约十次时钟读取）
+    void set_stage_timing(bool enabled) { stage_timing = enabled; }
+    [[nodiscard]] const psychology::EmotionProfile& get_emotion() const { return current_emotion; }
+    [[nodiscard]] const std::vector<float>& get_tendon_stress() const { return tendon_stress; }
+    [[nodiscard]] const std::vector<aino_math::Vec3>& get_joint_angles() const { return bridge.joint_angles; }
+    
+    // 绑定数据驱动的情绪姿态矩阵（空指针恢复默认）
+    void bind_emotion_map(std::shared_ptr<const EmotionMuscleMap> map) {
+        emotion_map = map ? std::move(map) : default_emotion_map();
+    }
+    
+    void bind_baked_clip(std::shared_ptr<const BakedClip> clip) {
+        baked_clip = std::move(clip);
+        baked_time = 0.0;
+    }
+    
+    void set_world_position(const aino_math::Vec3& p) { world_position = p; }
+    [[nodiscard]] const aino_math::Vec3& get_world_position() const { return world_position; }
+    
+    void set_perception_radius(float r) { perception_radius = std::max(r, 0.0f); }
+    [[nodiscard]] float get_perception_radius() const { return perception_radius; }
+    
+    // 创建收件箱（须在生产者线程开始投递前调用）；任意线程可 try_push
+    StimulusQueue& enable_inbox(size_t capacity = 256) {
+        if(!inbox) inbox = std::make_unique<StimulusQueue>(capacity);
+        return *inbox;
+    }
+    
+    [[nodiscard]] StimulusQueue* get_inbox() const { return inbox.get(); }
+    
+    // 评估特质（广播评估时写入 CrowdAppraisal）
+    [[nodiscard]] psychology::AppraisalTraits get_appraisal_traits() const {
+        return {traits.self_efficacy, traits.self_esteem, mood.get_state().stress};
+    }
+    
+    // 慢变量状态向量 = [代谢 | 心境 | 每肌肉结合比例]（长时积分的检查点）
+    [[nodiscard]] size_t slow_state_size() const {
+        return biology::MetabolicSystem::STATE_SIZE + psychology::MoodDynamics::STATE_SIZE + muscles.size();
+    }
+    
+    [[nodiscard]] std::vector<float> save_slow_state() const {
+        std::vector<float> state;
+        state.reserve(slow_state_size());
+        auto met = metabolism.save_state();
+        auto md = mood.save_state();
+        state.insert(state.end(), met.begin(), met.end());
+        state.insert(state.end(), md.begin(), md.end());
+        for(const auto& m : muscles) state.push_back(m.get_bound_fraction());
+        return state;
+    }
+    
+    void restore_slow_state(const std::vector<float>& state) {
+        if(state.size() != slow_state_size()) {
+            throw std::runtime_error("Slow state size mismatch");
+        }
+        const float* p = state.data();
+        std::array<float, biology::MetabolicSystem::STATE_SIZE> met;
+        std::array<float, psychology::MoodDynamics::STATE_SIZE> md;
+        std::copy(p, p + met.size(), met.begin()); p += met.size();
+        std::copy(p, p + md.size(), md.begin()); p += md.size();
+        metabolism.restore_state(met);
+        mood.restore_state(md);
+        current_emotion.mood = mood.get_state();
+        for(auto& m : muscles) {
+            m.set_bound_fraction(0.0f);   // 先清空分箱分布：结果与新建角色恢复同一检查点一致
+            m.set_bound_fraction(*p++);
+        }
+        
+        // 快变量（骨骼 / 脊髓 / 输出）回到静息，降频计数从检查点重新开始：同一角色可反复从检查点传播
+        skeleton = biology::ArticulatedSkeleton((int)skeleton.joint_count());
+        spinal_cord = neuroscience::SpinalCord((int)(muscles.size() / 2));
+        bridge.muscle_activations.clear();
+        bridge.joint_angles.clear();
+        lod_frame = 0;
+        lod_dt_accum = 0.0f;
+        metabolism_frame = 0;
+    }
+    
+    // 绑定训练好的代理模型（布局需与 surrogate_layout() 一致）
+    void bind_surrogate(std::shared_ptr<const learning::SurrogateMLP> model) {
+        surrogate = std::move(model);
+        surrogate_ws = {};
+        if(surrogate) {
+            surrogate_in.assign(surrogate->get_layout().input_size(), 0.0f);
+            surrogate_out.assign(surrogate->get_layout().output_size(), 0.0f);
+        }
+    }
+    
+    [[nodiscard]] learning::SurrogateLayout surrogate_layout() const {
+        return {skeleton.joint_count(), muscles.size() / 2};
+    }
+    
+    // 构图时绑定上游输出（每关节扭矩 / 刺激列表），求值时直接读取不拷贝
+    //   上游缓冲须比本节点存活更久
+    void bind_torque_input(const std::vector<float>& upstream) { bridge.torque_channel.bind(upstream); }
+    void bind_torque_input(const float* upstream, size_t count) { bridge.torque_channel.bind(upstream, count); }
+    void bind_stimulus_input(const std::vector<psychology::Stimulus>& upstream) { bridge.stimulus_channel.bind(upstream); }
+    void unbind_inputs() {
+        bridge.torque_channel.unbind();
+        bridge.stimulus_channel.unbind();
+    }
+    
+    void write_to_pose_buffer(aino_animation::PoseBuffer& pose) {
+        skeleton.write_to_pose_buffer(pose);
+        
+        // 疲劳震颤（叠加高频噪声）
+        if(bridge.fatigue_factor > 0.01f) {
+            float shake = bridge.fatigue_factor * 0.1f;
+            auto noise = aino_math::simd::noise4();
+            float temp[4];
+            _mm_store_ps(temp, noise);
+            
+            // 添加到根关节旋转
+            if(pose.bone_count > 0) {
+                pose.rotation_z[0] += shake * temp[0];
+            }
+        }
     }
     
     // 重写Aino节点接口
     void on_evaluate(aino_animation::AnimationContext& ctx) override {
-        bridge.desired_joint_torques.clear();
-        bridge.cognitive_stimuli.clear();
-        
-        // 从上下文提取扭矩需求
-        auto it = ctx.parameters.find("desired_torques");
-        if(it != ctx.parameters.end()) {
-            bridge.desired_joint_torques.resize(1, it->second);
+        // 未绑定通道时回退到标量参数（旧接口）
+        if(!bridge.torque_channel.bound()) {
+            bridge.desired_joint_torques.clear();
+            auto it = ctx.parameters.find("desired_torques");
+            if(it != ctx.parameters.end()) {
+                bridge.desired_joint_torques.resize(1, it->second);
+            }
         }
         
-        // 提取环境刺激
-        if(ctx.parameters.count("threat_distance")) {
-            bridge.cognitive_stimuli.push_back({
-                "threat",
-                1.0f / (ctx.parameters["threat_distance"] + 1.0f),
-                {0,0,0},
-                ctx.parameters.count("threat_urgency") ? ctx.parameters["threat_urgency"] : 0.5f
-            });
+        if(!bridge.stimulus_channel.bound()) {
+            bridge.cognitive_stimuli.clear();
+            if(ctx.parameters.count("threat_distance")) {
+                bridge.cognitive_stimuli.push_back({
+                    "threat",
+                    1.0f / (ctx.parameters["threat_distance"] + 1.0f),
+                    {0,0,0},
+                    ctx.parameters.count("threat_urgency") ? ctx.parameters["threat_urgency"] : 0.5f
+                });
+            }
         }
         
         update(ctx.delta_time, bridge);
@@ -165,6 +542,12 @@ public:
     }
     
 private:
+    // 进程内唯一角色ID（指标 / 超预算日志）
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+    
     void initialize_human_muscles() {
         muscles[TRAPEZIUS] = biology::Muscle(150); // 斜方肌，150根纤维
         muscles[RECTUS_ABDOMINIS] = biology::Muscle(200); // 腹直肌
@@ -180,72 +563,153 @@ private:
         }
     }
     
-    void apply_emotion_to_muscles(const psychology::EmotionProfile& emotion) {
-        // 恐惧→斜方肌紧张
-        if(TRAPEZIUS < muscles.size()) {
-            float trap_activation = emotion.primary.fear * 0.7f;
-            muscles[TRAPEZIUS].step(trap_activation, 0.016f);
+    // 内置默认矩阵（静态对象，不参与所有权）
+    static std::shared_ptr<const EmotionMuscleMap> default_emotion_map() {
+        return {std::shared_ptr<const EmotionMuscleMap>(), &EmotionMuscleMap::default_map()};
+    }
+    
+    [[nodiscard]] bool has_surrogate() const {
+        return surrogate && !surrogate->empty();
+    }
+    
+    // 全局Surrogate精度优先，其次按LOD档位；代理未绑定时退化为矩模型
+    [[nodiscard]] MuscleModel active_muscle_model(Accuracy accuracy) const {
+        if(has_surrogate() && accuracy == Accuracy::Surrogate) {
+            return MuscleModel::Surrogate;
+        }
+        if(lod.muscle_model == MuscleModel::Surrogate && !has_surrogate()) {
+            return MuscleModel::Moment;
+        }
+        return lod.muscle_model;
+    }
+    
+    // LOD网格优先，否则跟随全局精度；仅在变化时重采样
+    void sync_grid_size(Accuracy accuracy) {
+        int grid = lod.grid_size > 0 ? lod.grid_size : Engine::grid_size_for(accuracy);
+        if(grid == applied_grid) return;
+        for(auto& m : muscles) m.set_grid_size(grid);
+        applied_grid = grid;
+    }
+    
+    void play_baked(float dt) {
+        if(!baked_clip || baked_clip->empty()) return; // 无片段：保持当前姿态
+        baked_time += dt;
+        const auto& frame = baked_clip->sample(baked_time);
+        for(size_t i = 0; i < frame.size(); ++i) {
+            skeleton.set_joint_rotation_z(i, frame[i]);
+        }
+    }
+    
+    // 关闭神经子系统时：期望扭矩直接映射为激活
+    void activations_from_torques(aino_animation::Span<float> torques) {
+        bridge.muscle_activations.resize(muscles.size() / 2);
+        for(size_t i = 0; i < bridge.muscle_activations.size(); ++i) {
+            bridge.muscle_activations[i] = i < torques.size() ? std::clamp(torques[i], -1.0f, 1.0f) : 0.0f;
+        }
+    }
+    
+    void run_surrogate(const PhysioBridge& input) {
+        const auto& layout = surrogate->get_layout();
+        float* in = surrogate_in.data();
+        
+        // 输入 = [期望扭矩 | 刺激特征 | 上一帧激活 | 上一帧关节角]
+        const auto torques = input.torques();
+        const auto stimuli = input.stimuli();
+        for(size_t i = 0; i < layout.joint_count; ++i) {
+            *in++ = i < torques.size() ? torques[i] : 0.0f;
+        }
+        auto stim_feat = learning::stimulus_features(stimuli.data(), stimuli.size());
+        in = std::copy(stim_feat.begin(), stim_feat.end(), in);
+        for(size_t i = 0; i < layout.activation_count; ++i) {
+            *in++ = i < bridge.muscle_activations.size() ? bridge.muscle_activations[i] : 0.0f;
+        }
+        for(size_t i = 0; i < layout.joint_count; ++i) {
+            *in++ = i < bridge.joint_angles.size() ? bridge.joint_angles[i].z : 0.0f;
         }
         
-        // 悲伤→躯干屈曲
-        if(RECTUS_ABDOMINIS < muscles.size()) {
-            float ab_activation = emotion.primary.sadness * 0.6f;
-            muscles[RECTUS_ABDOMINIS].step(ab_activation, 0.016f);
+        surrogate->forward(surrogate_in.data(), surrogate_out.data(), surrogate_ws);
+        
+        // 输出 = [节段净驱动 | 关节角]；回归输出可能越界，净驱动截断到 [-1, 1]
+        bridge.muscle_activations.resize(layout.activation_count);
+        for(size_t i = 0; i < layout.activation_count; ++i) {
+            bridge.muscle_activations[i] = std::clamp(surrogate_out[i], -1.0f, 1.0f);
+        }
+        for(size_t i = 0; i < layout.joint_count; ++i) {
+            skeleton.set_joint_rotation_z(i, surrogate_out[layout.activation_count + i]);
         }
     }
     
-    void update_muscles_parallel(float dt) {
-        perf.muscle_updates = muscles.size();
+    // 拮抗对：肌肉 2s / 2s+1 为第 s 节段的屈 / 伸肌，节段净驱动按符号分配
+    float muscle_activation(size_t i) const {
+        const size_t segment = i / 2;
+        const float drive = segment < bridge.muscle_activations.size() ? bridge.muscle_activations[segment] : 0.0f;
+        float a = i % 2 == 0 ? std::max(drive, 0.0f) : std::max(-drive, 0.0f);
+        a = std::clamp(a + emotion_drive[i], 0.0f, 1.0f);   // 情绪权重可为负（抑制）
+        // 自适应精度：热节流时降采样
+        return (perf.is_thermal_throttling && (i % 4 == 0)) ? a * 0.5f : a;
+    }
+    
+    // 可中断肌肉阶段：全部先做O(1)估计，再按优先级精算直到截止时间
+    void update_muscles_parallel(float dt, std::chrono::steady_clock::time_point deadline,
+                                 bool allow_refine = true) {
+        const size_t count = muscles.size();
         
-        #pragma omp parallel for schedule(dynamic, 4)
-        for(size_t i = 0; i < muscles.size(); ++i) {
-            // 自适应精度：热节流时降采样
-            if(perf.is_thermal_throttling && (i % 4 == 0)) {
-                muscles[i].step(bridge.muscle_activations[i] * 0.5f, dt);
-            } else {
-                muscles[i].step(bridge.muscle_activations[i], dt);
-            }
+        // 1. 廉价估计（保证截止时每块肌肉都有输出）
+        refine_order.resize(count);
+        refine_priority.resize(count);
+        for(size_t i = 0; i < count; ++i) {
+            float a = muscle_activation(i);
+            float delta = std::abs(a - muscles[i].get_last_activation());
+            muscles[i].estimate(a, dt);
+            
+            // 优先级：可见 > 激活变化 > 质量
+            refine_priority[i] = (muscles[i].is_visible() ? 10.0f : 0.0f) +
+                                 delta * 5.0f + muscles[i].get_mass();
+            refine_order[i] = i;
+        }
+        if(!allow_refine) {
+            perf.muscle_updates = 0;
+            return;
+        }
+        std::sort(refine_order.begin(), refine_order.end(), [&](size_t a, size_t b) {
+            return refine_priority[a] > refine_priority[b];
+        });
+        
+        // 2. 按优先级精算，超时的保留估计值
+        size_t refined_count = 0;
+        #pragma omp parallel for schedule(dynamic, 1) reduction(+:refined_count)
+        for(size_t k = 0; k < count; ++k) {
+            if(std::chrono::steady_clock::now() >= deadline) continue;
+            size_t i = refine_order[k];
+            muscles[i].refine();
+            ++refined_count;
+        }
+        perf.muscle_updates = refined_count;
+    }
+    
+    // 关节 j 由拮抗对 2j / 2j+1 驱动：扭矩 = 最大扭矩 × (屈肌 − 伸肌)，力按满激活稳态归一化
+    void apply_muscle_torques() {
+        const size_t count = std::min(skeleton.joint_count(), muscles.size() / 2);
+        for(size_t j = 0; j < count; ++j) {
+            const auto& flexor = muscles[2 * j];
+            const auto& extensor = muscles[2 * j + 1];
+            const float net = flexor.get_force() / flexor.get_max_force() - extensor.get_force() / extensor.get_max_force();
+            skeleton.set_muscle_torque(j, {0.0f, 0.0f, MAX_JOINT_TORQUE * net});
         }
     }
     
     void update_tendons(float dt) {
+        const size_t count = std::min(tendons.size(), muscles.size());
         #pragma omp parallel for
-        for(size_t i = 0; i < tendons.size() && i < muscles.size(); ++i) {
+        for(size_t i = 0; i < count; ++i) {
             // 计算应变（简化：力/刚度）
             float force = muscles[i].get_force();
             float strain = force / tendons[i].get_stiffness();
             float strain_rate = strain / (dt + 1e-6f);
             
-            tendons[i].compute_stress(strain, strain_rate, dt);
-        }
-    }
-    
-    void write_to_pose_buffer(aino_animation::PoseBuffer& pose) {
-        skeleton.write_to_pose_buffer(pose);
-        
-        // 疲劳震颤（叠加高频噪声）
-        if(bridge.fatigue_factor > 0.01f) {
-            float shake = bridge.fatigue_factor * 0.1f;
-            auto noise = aino_math::simd::noise4();
-            float temp[4];
-            _mm_store_ps(temp, noise);
-            
-            // 添加到根关节旋转
-            if(pose.bone_count > 0) {
-                pose.rotation_z[0] += shake * temp[0];
-            }
+            tendon_stress[i] = tendons[i].compute_stress(strain, strain_rate, dt);
         }
     }
-    
-    // 情绪混合（最大值策略）
-    void blend_emotions_max(psychology::EmotionProfile& base, 
-                           const psychology::EmotionProfile& add) {
-        base.primary.joy = std::max(base.primary.joy, add.primary.joy);
-        base.primary.sadness = std::max(base.primary.sadness, add.primary.sadness);
-        base.primary.anger = std::max(base.primary.anger, add.primary.anger);
-        base.primary.fear = std::max(base.primary.fear, add.primary.fear);
-        // ... 其他情绪分量
-    }
 };
 
 } // namespace systems
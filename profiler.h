@@ -0,0 +1,340 @@
+// =====================================================
+// profiler.hpp - 作用域计时区（每线程无锁环形缓冲）
+// =====================================================
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <array>
+#include <algorithm>
+#include <ostream>
+
+// 编译期开关：AINO_PROFILE=0 时 AINO_ZONE 展开为空，不读时钟也不引用 Profiler
+#ifndef AINO_PROFILE
+#define AINO_PROFILE 0
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define AINO_PROFILE_RDTSC 1
+#endif
+
+namespace aino_pro {
+
+// 时间戳：x86 上为TSC周期（约7ns/次），导出时按墙钟换算为纳秒
+inline uint64_t profile_ticks() {
+#ifdef AINO_PROFILE_RDTSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ZoneEvent {
+    const char* name;   // 静态字符串（字面量 / stage_name），不拷贝
+    uint64_t begin;
+    uint64_t end;
+};
+
+// 单写者环形缓冲：所属线程写入，任意线程快照；写满后覆盖最旧事件
+//   槽位字段为 relaxed 原子（x86 上即普通 mov）：快照与覆盖并发时读到的可能是新旧混合，由 head 复核丢弃
+class ZoneRing {
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> begin{0};
+        std::atomic<uint64_t> end{0};
+    };
+    std::unique_ptr<Slot[]> events;
+    const uint64_t mask;
+    std::atomic<uint64_t> head{0};      // 已写入事件总数
+    std::atomic<uint64_t> floor{0};     // clear() 时的 head，快照忽略其前事件
+    const uint32_t thread_index;
+    
+public:
+    ZoneRing(size_t capacity_pow2, uint32_t index)
+        : events(new Slot[capacity_pow2]), mask(capacity_pow2 - 1), thread_index(index) {}
+    
+    void push(const char* name, uint64_t begin, uint64_t end) {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        // 上一次 head 发布先于本次槽位写入可见：快照读到新槽位时，复核的 head 至少为 h（x86 上仅编译器屏障）
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = events[h & mask];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        head.store(h + 1, std::memory_order_release);
+    }
+    
+    // 复制仍有效的事件；复制期间被覆盖的槽位按二次读取的 head 丢弃
+    //   写者可能正在写第 h2 个事件（槽位与第 h2 - capacity 个相同），故有效起点为 h2 + 1 - capacity
+    void snapshot(std::vector<ZoneEvent>& out) const {
+        const uint64_t capacity = mask + 1;
+        uint64_t h = head.load(std::memory_order_acquire);
+        uint64_t first = std::max(h > capacity ? h - capacity : 0, floor.load(std::memory_order_relaxed));
+        
+        size_t base = out.size();
+        for(uint64_t i = first; i < h; ++i) {
+            const Slot& slot = events[i & mask];
+            out.push_back({slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed),
+                           slot.end.load(std::memory_order_relaxed)});
+        }
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t h2 = head.load(std::memory_order_relaxed);
+        uint64_t valid_from = h2 + 1 > capacity ? h2 + 1 - capacity : 0;
+        if(valid_from > first) {
+            size_t drop = (size_t)std::min(valid_from - first, h - first);
+            out.erase(out.begin() + base, out.begin() + base + drop);
+        }
+    }
+    
+    void clear() { floor.store(head.load(std::memory_order_acquire), std::memory_order_relaxed); }
+    
+    [[nodiscard]] uint32_t get_thread_index() const { return thread_index; }
+    [[nodiscard]] uint64_t total_events() const { return head.load(std::memory_order_relaxed); }
+};
+
+// 按区名聚合的耗时直方图（log2 纳秒桶）
+struct ZoneSummary {
+    static constexpr size_t BUCKETS = 40;   // [2^i, 2^(i+1)) ns
+    
+    const char* name = "";
+    size_t count = 0;
+    double total_ns = 0.0, min_ns = 0.0, max_ns = 0.0;
+    std::array<uint64_t, BUCKETS> buckets{};
+    
+    [[nodiscard]] double mean_ns() const { return count ? total_ns / count : 0.0; }
+    
+    // 桶内按几何中点估计
+    [[nodiscard]] double percentile_ns(double q) const {
+        if(!count) return 0.0;
+        uint64_t rank = (uint64_t)std::ceil(q * count), seen = 0;
+        for(size_t b = 0; b < BUCKETS; ++b) {
+            seen += buckets[b];
+            if(seen >= std::max<uint64_t>(rank, 1)) {
+                return std::clamp(std::ldexp(1.41421356, (int)b), min_ns, max_ns);
+            }
+        }
+        return max_ns;
+    }
+    
+    void add(double ns) {
+        min_ns = count ? std::min(min_ns, ns) : ns;
+        max_ns = count ? std::max(max_ns, ns) : ns;
+        total_ns += ns;
+        ++count;
+        size_t b = ns >= 1.0 ? std::min<size_t>((size_t)std::log2(ns), BUCKETS - 1) : 0;
+        ++buckets[b];
+    }
+};
+
+// 进程级采集器：线程首次记录时注册环形缓冲（仅此处加锁）
+class Profiler {
+    std::atomic<bool> enabled{false};
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<ZoneRing>> rings;   // 线程退出后保留，便于导出
+    size_t ring_capacity = size_t(1) << 15;
+    
+    // 时钟换算原点
+    uint64_t origin_ticks;
+    std::chrono::steady_clock::time_point origin_time;
+    
+    Profiler() : origin_ticks(profile_ticks()), origin_time(std::chrono::steady_clock::now()) {}
+    
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+    
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+    
+    // 运行时开关（关闭时每个区只有一次 relaxed 原子读）
+    void set_enabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+    [[nodiscard]] bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+    
+    // 新注册线程的缓冲容量（向上取2的幂）
+    void set_ring_capacity(size_t events) {
+        size_t c = 1;
+        while(c < std::max<size_t>(events, 2)) c <<= 1;
+        std::lock_guard<std::mutex> lock(mutex);
+        ring_capacity = c;
+    }
+    
+    void record(const char* name, uint64_t begin, uint64_t end) {
+        thread_local ZoneRing* t_ring = nullptr;
+        if(!t_ring) t_ring = &register_thread();
+        t_ring->push(name, begin, end);
+    }
+    
+    // 丢弃已记录事件（不打断写入线程）
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(auto& r : rings) r->clear();
+    }
+    
+    [[nodiscard]] double ns_per_tick() const {
+#ifdef AINO_PROFILE_RDTSC
+        // 与墙钟对比标定；间隔过短时等待以保证精度
+        auto now = std::chrono::steady_clock::now();
+        while(now - origin_time < std::chrono::milliseconds(10)) now = std::chrono::steady_clock::now();
+        uint64_t ticks = profile_ticks();
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - origin_time).count();
+        return ticks > origin_ticks ? ns / double(ticks - origin_ticks) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+    
+    // 按线程快照（线程序号, 事件）
+    [[nodiscard]] std::vector<std::pair<uint32_t, std::vector<ZoneEvent>>> collect() const {
+        std::vector<std::shared_ptr<ZoneRing>> current;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = rings;
+        }
+        std::vector<std::pair<uint32_t, std::vector<ZoneEvent>>> out;
+        out.reserve(current.size());
+        for(const auto& r : current) {
+            out.emplace_back(r->get_thread_index(), std::vector<ZoneEvent>());
+            r->snapshot(out.back().second);
+        }
+        return out;
+    }
+    
+    // 1. 按区名聚合直方图
+    [[nodiscard]] std::vector<ZoneSummary> summarize() const {
+        const double scale = ns_per_tick();
+        std::vector<ZoneSummary> out;
+        for(const auto& [thread, events] : collect()) {
+            for(const auto& e : events) {
+                auto it = std::find_if(out.begin(), out.end(), [&](const ZoneSummary& s) {
+                    return s.name == e.name || !std::strcmp(s.name, e.name);
+                });
+                if(it == out.end()) {
+                    out.emplace_back();
+                    it = out.end() - 1;
+                    it->name = e.name;
+                }
+                it->add(double(e.end - e.begin) * scale);
+            }
+        }
+        std::sort(out.begin(), out.end(), [](const ZoneSummary& a, const ZoneSummary& b) {
+            return a.total_ns > b.total_ns;
+        });
+        return out;
+    }
+    
+    // 2. Chrome Trace Event 格式（chrome://tracing / Perfetto 可直接打开）
+    void write_chrome_trace(std::ostream& os) const {
+        const double scale = ns_per_tick() * 1e-3;   // → 微秒
+        auto threads = collect();
+        
+        os << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+        bool first = true;
+        char buf[256];
+        for(const auto& [thread, events] : threads) {
+            std::snprintf(buf, sizeof(buf),
+                          "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": {\"name\": \"aino-%u\"}}",
+                          first ? "" : ",", thread, thread);
+            os << buf;
+            first = false;
+            for(const auto& e : events) {
+                double ts = double(int64_t(e.begin - origin_ticks)) * scale;
+                double dur = double(e.end - e.begin) * scale;
+                std::snprintf(buf, sizeof(buf),
+                              ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}",
+                              e.name, thread, ts, dur);
+                os << buf;
+            }
+        }
+        os << "\n]}\n";
+    }
+    
+    void write_summary_json(std::ostream& os) const {
+        auto zones = summarize();
+        os << "[";
+        for(size_t i = 0; i < zones.size(); ++i) {
+            const auto& z = zones[i];
+            os << (i ? ",\n    " : "\n    ")
+               << "{\"name\": \"" << z.name << "\", \"count\": " << z.count
+               << ", \"total_ms\": " << z.total_ns * 1e-6 << ", \"mean_ns\": " << z.mean_ns()
+               << ", \"min_ns\": " << z.min_ns << ", \"p50_ns\": " << z.percentile_ns(0.50)
+               << ", \"p99_ns\": " << z.percentile_ns(0.99) << ", \"max_ns\": " << z.max_ns
+               << ", \"log2_ns_buckets\": [";
+            size_t last = z.BUCKETS;
+            while(last > 0 && !z.buckets[last - 1]) --last;
+            for(size_t b = 0; b < last; ++b) os << (b ? ", " : "") << z.buckets[b];
+            os << "]}";
+        }
+        os << (zones.empty() ? "]" : "\n  ]");
+    }
+    
+private:
+    ZoneRing& register_thread() {
+        std::lock_guard<std::mutex> lock(mutex);
+        rings.push_back(std::make_shared<ZoneRing>(ring_capacity, (uint32_t)rings.size()));
+        return *rings.back();
+    }
+};
+
+// RAII 计时区（运行时关闭时不读时钟）
+class ScopedZone {
+    const char* name;
+    uint64_t begin;
+    
+public:
+    explicit ScopedZone(const char* zone_name)
+        : name(zone_name), begin(Profiler::instance().is_enabled() ? profile_ticks() : 0) {}
+    
+    ~ScopedZone() {
+        if(begin) Profiler::instance().record(name, begin, profile_ticks());
+    }
+    
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+};
+
+// 相邻计时区链：上一区的结束时刻即下一区的开始时刻，每个边界只读一次时钟
+//   独立 ScopedZone 每区读两次时钟（x86 虚拟机上 rdtsc 约 20ns/次），连续分段计时用此类
+class ZoneChain {
+    uint64_t last = 0;  // 0 = 未开启
+    
+public:
+    // 运行时关闭时不读时钟，后续 lap 均为空操作
+    void begin() { last = Profiler::instance().is_enabled() ? profile_ticks() : 0; }
+    
+    // 结束当前区（记为 name），同时开始下一区
+    void lap(const char* name) {
+        if(!last) return;
+        uint64_t now = profile_ticks();
+        Profiler::instance().record(name, last, now);
+        last = now;
+    }
+};
+
+} // namespace aino_pro
+
+#define AINO_ZONE_CONCAT_(a, b) a##b
+#define AINO_ZONE_CONCAT(a, b) AINO_ZONE_CONCAT_(a, b)
+
+#if AINO_PROFILE
+#define AINO_ZONE(name) ::aino_pro::ScopedZone AINO_ZONE_CONCAT(aino_zone_, __LINE__)(name)
+#else
+#define AINO_ZONE(name) ((void)0)
+#endif
@@ -6,6 +6,7 @@
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include "../profiler.hpp"
 
 namespace aino_pro {
 namespace neuroscience {
@@ -81,6 +82,9 @@ public:
     void set_spindle_feedback(float feedback) { spindle_feedback = feedback; }
     void set_tendon_force(float force) { tendon_force = force; }
     
+    [[nodiscard]] float get_setpoint() const { return setpoint; }
+    [[nodiscard]] float get_spindle_feedback() const { return spindle_feedback; }
+    
     // 计算Ib抑制（腱器官）
     void update_ib_inhibition() {
         float ib_threshold = 0.8f;
@@ -104,7 +108,7 @@ public:
         // 1. 肌梭反馈（长度+速度）
         float spindle_gain = 100.0f;
         float spindle_vel_gain = 5.0f;
-        float spindle_feedback = (joint_angle - flexor.setpoint) * spindle_gain + 
+        float spindle_feedback = (joint_angle - flexor.get_setpoint()) * spindle_gain + 
                                   joint_velocity * spindle_vel_gain;
         
         // 2. 设置神经元池输入
@@ -134,8 +138,8 @@ public:
     void set_emotional_modulation(float fear) {
         // 恐惧→γ增益↑（肌梭敏感化）
         float gamma_gain = 1.0f + fear * 0.5f;
-        flexor.set_spindle_feedback(flexor.spindle_feedback * gamma_gain);
-        extensor.set_spindle_feedback(extensor.spindle_feedback * gamma_gain);
+        flexor.set_spindle_feedback(flexor.get_spindle_feedback() * gamma_gain);
+        extensor.set_spindle_feedback(extensor.get_spindle_feedback() * gamma_gain);
         
         // 减少Renshaw抑制，允许共收缩
         // 注意：直接修改私有成员需要友元或接口，这里简化
@@ -154,7 +158,13 @@ public:
     explicit SpinalCord(int segment_count = 5) : segments(segment_count) {}
     
     void step(const std::vector<float>& desired_torques, float dt) {
-        if(desired_torques.size() != segments.size()) return;
+        step(desired_torques.data(), desired_torques.size(), dt);
+    }
+    
+    // 直接读取上游扭矩缓冲（零拷贝）
+    void step(const float* desired_torques, size_t count, float dt) {
+        if(count != segments.size()) return;
+        AINO_ZONE("spinal_cord.step");
         
         #pragma omp parallel for
         for(size_t i = 0; i < segments.size(); ++i) {
@@ -163,6 +173,10 @@ public:
         }
     }
     
+    void set_emotional_modulation(float fear) {
+        for(auto& segment : segments) segment.set_emotional_modulation(fear);
+    }
+    
     [[nodiscard]] std::vector<float> get_muscle_activations() const {
         std::vector<float> activations(segments.size());
         for(size_t i = 0; i < segments.size(); ++i) {
@@ -0,0 +1,174 @@
+// =====================================================
+// aino_pro/systems/stimulus_index.hpp
+// =====================================================
+
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include "../aino_math.hpp"
+#include "../psychology/cognitive_appraisal.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 世界级刺激空间哈希（均匀网格）
+//   增量维护：刺激按ID upsert，仅在跨格时重新分桶
+//   查询只读，可在多个角色间并行
+class StimulusIndex {
+    struct Record {
+        uint32_t id;
+        psychology::StimulusCategory category;
+        float intensity, urgency, familiarity, predictability;
+        aino_math::Vec3 position;
+        uint64_t cell;
+        uint32_t cell_slot;     // 在所属格子列表中的下标（O(1)删除）
+        uint64_t last_seen;
+    };
+    
+    aino_math::GridHash grid;
+    std::vector<Record> records;
+    std::unordered_map<uint32_t, uint32_t> slot_of;              // ID → records下标
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;   // 格子 → records下标
+    uint64_t frame = 0;
+    
+public:
+    explicit StimulusIndex(float cell = 5.0f) : grid{cell} {
+        if(cell <= 0.0f) throw std::runtime_error("Stimulus cell size must be positive");
+    }
+    
+    [[nodiscard]] size_t size() const { return records.size(); }
+    [[nodiscard]] float get_cell_size() const { return grid.cell_size; }
+    
+    // 插入或更新（匿名刺激无法索引）
+    void upsert(const psychology::Stimulus& s) {
+        if(s.id == 0) throw std::runtime_error("Indexed stimulus requires a non-zero id");
+        
+        uint64_t cell = grid.key(s.position);
+        auto it = slot_of.find(s.id);
+        if(it == slot_of.end()) {
+            uint32_t slot = (uint32_t)records.size();
+            records.push_back({s.id, s.resolved_category(), s.intensity, s.urgency,
+                               s.familiarity, s.predictability, s.position, cell, 0, frame});
+            slot_of[s.id] = slot;
+            link(slot);
+            return;
+        }
+        
+        Record& r = records[it->second];
+        r.category = s.resolved_category();
+        r.intensity = s.intensity;
+        r.urgency = s.urgency;
+        r.familiarity = s.familiarity;
+        r.predictability = s.predictability;
+        r.position = s.position;
+        r.last_seen = frame;
+        if(r.cell != cell) {
+            unlink(it->second);
+            r.cell = cell;
+            link(it->second);
+        }
+    }
+    
+    void remove(uint32_t id) {
+        auto it = slot_of.find(id);
+        if(it == slot_of.end()) return;
+        uint32_t slot = it->second;
+        unlink(slot);
+        slot_of.erase(it);
+        
+        // 末尾记录填补空位
+        uint32_t last = (uint32_t)records.size() - 1;
+        if(slot != last) {
+            records[slot] = records[last];
+            slot_of[records[slot].id] = slot;
+            cells[records[slot].cell][records[slot].cell_slot] = slot;
+        }
+        records.pop_back();
+    }
+    
+    void clear() {
+        records.clear();
+        slot_of.clear();
+        cells.clear();
+    }
+    
+    // 每帧增量同步：upsert本帧全部刺激，移除本帧未出现的
+    void sync(const std::vector<psychology::Stimulus>& frame_stimuli) {
+        ++frame;
+        for(const auto& s : frame_stimuli) {
+            if(s.id != 0) upsert(s);
+        }
+        for(size_t i = records.size(); i-- > 0;) {
+            if(records[i].last_seen != frame) remove(records[i].id);
+        }
+    }
+    
+    // 感知查询：半径内刺激追加到 out，强度/紧迫度按 (1 - d²/r²)² 衰减
+    void query(const aino_math::Vec3& center, float radius, psychology::StimulusBatch& out) const {
+        if(radius <= 0.0f || records.empty()) return;
+        const float r2 = radius * radius;
+        
+        auto visit = [&](const Record& r) {
+            aino_math::Vec3 d = r.position - center;
+            float d2 = aino_math::dot(d, d);
+            if(d2 >= r2) return;
+            float w = 1.0f - d2 / r2;
+            w *= w;
+            out.push(r.category, r.intensity * w, r.position, r.urgency * w,
+                     r.familiarity, r.predictability, r.id);
+        };
+        
+        int x0 = grid.coord(center.x - radius), x1 = grid.coord(center.x + radius);
+        int y0 = grid.coord(center.y - radius), y1 = grid.coord(center.y + radius);
+        int z0 = grid.coord(center.z - radius), z1 = grid.coord(center.z + radius);
+        
+        // 覆盖格子数多于记录数时直接线性扫描
+        double span = double(x1 - x0 + 1) * (y1 - y0 + 1) * (z1 - z0 + 1);
+        if(span > (double)records.size()) {
+            for(const auto& r : records) visit(r);
+            return;
+        }
+        
+        for(int x = x0; x <= x1; ++x)
+        for(int y = y0; y <= y1; ++y)
+        for(int z = z0; z <= z1; ++z) {
+            auto it = cells.find(aino_math::GridHash::pack(x, y, z));
+            if(it == cells.end()) continue;
+            for(uint32_t slot : it->second) visit(records[slot]);
+        }
+    }
+    
+    // 并行查询：每个角色一个感知批（调用前清空由调用方决定）
+    void query_batch(const aino_math::Vec3* centers, const float* radii,
+                     psychology::StimulusBatch* outs, size_t count) const {
+        #pragma omp parallel for schedule(dynamic, 16)
+        for(size_t i = 0; i < count; ++i) {
+            outs[i].clear();
+            query(centers[i], radii[i], outs[i]);
+        }
+    }
+    
+private:
+    void link(uint32_t slot) {
+        auto& list = cells[records[slot].cell];
+        records[slot].cell_slot = (uint32_t)list.size();
+        list.push_back(slot);
+    }
+    
+    void unlink(uint32_t slot) {
+        auto it = cells.find(records[slot].cell);
+        auto& list = it->second;
+        uint32_t pos = records[slot].cell_slot;
+        list[pos] = list.back();
+        records[list[pos]].cell_slot = pos;
+        list.pop_back();
+        if(list.empty()) cells.erase(it);
+    }
+};
+
+} // namespace systems
+} // namespace aino_pro
@@ -0,0 +1,124 @@
+// =====================================================
+// aino_pro/systems/stimulus_queue.hpp
+// =====================================================
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "../psychology/cognitive_appraisal.hpp"
+
+namespace aino_pro {
+namespace systems {
+
+// 紧凑刺激记录（POD，跨线程按值拷贝）
+struct StimulusRecord {
+    uint32_t id = 0;
+    psychology::StimulusCategory category = psychology::StimulusCategory::Neutral;
+    float intensity = 0.0f;
+    float urgency = 0.0f;
+    float familiarity = 0.5f;
+    float predictability = 0.5f;
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    
+    static StimulusRecord from(const psychology::Stimulus& s) {
+        return {s.id, s.resolved_category(), s.intensity, s.urgency,
+                s.familiarity, s.predictability, s.position.x, s.position.y, s.position.z};
+    }
+};
+
+// 有界多生产者/单消费者无锁环形队列（预分配，每槽序号同步）
+//   生产者：任意线程 try_push，队满时丢弃并计数
+//   消费者：仿真线程在帧起点 drain
+template<typename T>
+class MpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "MpscRing requires trivially copyable records");
+    
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0};    // 生产者共享
+    alignas(64) size_t head = 0;                // 仅消费者访问
+    alignas(64) std::atomic<size_t> dropped{0};
+    
+public:
+    // 容量向上取整到2的幂
+    explicit MpscRing(size_t capacity = 256) {
+        size_t size = 2;
+        while(size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for(size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+    
+    bool try_push(const T& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for(;;) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if(diff == 0) {
+                // 抢占槽位后写入，再以序号发布
+                if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if(diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false; // 队满
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    bool try_pop(T& out) {
+        Cell& cell = cells[head & mask];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if((intptr_t)seq - (intptr_t)(head + 1) < 0) return false; // 空，或生产者尚未发布
+        out = cell.data;
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+    
+    // 取出当前已发布的全部记录（最多 max_count 条）
+    template<typename Fn>
+    size_t drain(Fn&& fn, size_t max_count = SIZE_MAX) {
+        size_t count = 0;
+        T value;
+        while(count < max_count && try_pop(value)) {
+            fn(value);
+            ++count;
+        }
+        return count;
+    }
+    
+    [[nodiscard]] size_t capacity() const { return mask + 1; }
+    
+    // 自上次调用以来因队满丢弃的记录数
+    size_t take_dropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+};
+
+using StimulusQueue = MpscRing<StimulusRecord>;
+
+// 帧起点：队列 → SoA批（追加）
+inline size_t drain_into(StimulusQueue& queue, psychology::StimulusBatch& batch) {
+    return queue.drain([&](const StimulusRecord& r) {
+        batch.push(r.category, r.intensity, {r.x, r.y, r.z}, r.urgency,
+                   r.familiarity, r.predictability, r.id);
+    });
+}
+
+} // namespace systems
+} // namespace aino_pro